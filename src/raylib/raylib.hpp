@@ -4,156 +4,218 @@
  *  uncomment the example main as the end of this file to see it in action
  */
 #include <raylib.h>
+#include <rlgl.h>
 #include <string>
 #include <vector>
 #include <stdexcept>
 #include <iostream>
+#include <cstring>
 #include"color.h"
+#include "arena.hpp"
+#include "alpha.hpp"
+#include "resolution.hpp"
+#include "idle.hpp"
+#include "capture.hpp"
 
 
-//--------------------------OBJ----------------------------------------------------
-/**
- * @class Obj
- * @brief Represents a general object that can be rendered with static or animated textures.
- * @brief you can use to render objects of a single sprite (e.g player.png) where the sprite is a single image and may not need to change (!animatable)
- * @brief if also the object needs to be animated but the sprite are of different files; create an array of the files path and then pass the array variable to where you would pass the single image path as usual
- * @brief the both above are made possible by default parameters to functions and constructor so that depending on what users want then the changed variables will be passed
- */
-class Obj {
-public:
-    int x, y;                      // Position
-    float scale;                   // Scale for rendering
-    std::vector<Texture2D> textures; // Textures (single or multiple for animation)
-    int current_frame;             // Current animation frame
-    float frame_time;              // Time per frame (defaults to 1.0f for static objects)
-    float elapsed_time;            // Time accumulator
-
-    Obj(const std::string& path, int x_pos, int y_pos, float scale_factor, float frame_duration = 1.0f)
-        : x(x_pos), y(y_pos), scale(scale_factor), current_frame(0), frame_time(frame_duration), elapsed_time(0.0f) {
-        Texture2D texture = LoadTexture(path.c_str());
-        if (texture.id != 0) {
-            textures.push_back(texture);
-        } else {
-            throw std::runtime_error("Failed to load texture: " + path);
-        }
-    }
+//---------------------------------------- other func -------------------------------------------
 
-    Obj(const std::vector<std::string>& paths, int x_pos, int y_pos, float scale_factor, float frame_duration)
-        : x(x_pos), y(y_pos), scale(scale_factor), current_frame(0), frame_time(frame_duration), elapsed_time(0.0f) {
-        for (const auto& path : paths) {
-            Texture2D texture = LoadTexture(path.c_str());
-            if (texture.id != 0) {
-                textures.push_back(texture);
-            } else {
-                throw std::runtime_error("Failed to load texture: " + path);
-            }
-        }
-    }
+// Scratch memory for the current frame, reset in stop_drawing
+static FrameArena main_frame_arena;
 
-    ~Obj() {
-        for (auto& texture : textures) {
-            UnloadTexture(texture);
-        }
-    }
+// Blending is turned off while opaque textures are drawn
+static bool main_blend_disabled = false;
 
-    void render(float delta_time = 0.0f) {
-        if (textures.empty()) return;
+// Switch blending off for opaque draws and back on for everything else; flushes raylib's batch on a change
+void set_opaque_drawing(bool opaque) {
+    if (opaque == main_blend_disabled) return;
+    rlDrawRenderBatchActive();
+    if (opaque) rlDisableColorBlend();
+    else rlEnableColorBlend();
+    main_blend_disabled = opaque;
+}
 
-        if (textures.size() > 1) {
-            elapsed_time += delta_time;
-            if (elapsed_time >= frame_time) {
-                current_frame = (current_frame + 1) % textures.size();
-                elapsed_time = 0.0f;
-            }
-        }
+//---------------------------------------- logical resolution -------------------------------------------
 
-        const Texture2D& texture = textures[current_frame];
-        Rectangle dst = {
-            static_cast<float>(x),
-            static_cast<float>(y),
-            texture.width * scale,
-            texture.height * scale
-        };
-        DrawTexturePro(texture, {0, 0, static_cast<float>(texture.width), static_cast<float>(texture.height)}, dst, {0, 0}, 0.0f, WHITE);
+static int main_logical_width = 0;          // Size the game draws in, 0 draws straight to the window
+static int main_logical_height = 0;
+static float main_render_scale = 1.0f;      // Offscreen target size as a fraction of the logical size
+static RenderTexture2D main_target = {};
+static bool main_target_active = false;     // Drawing into main_target this frame
+static double main_frame_start = 0.0;
+static float main_last_frame_ms = 0.0f;
+
+// Draw in a width x height space, scaled up to the window in stop_drawing; 0, 0 turns it off
+void set_logical_resolution(int width, int height) {
+    main_logical_width = width > 0 ? width : 0;
+    main_logical_height = height > 0 ? height : 0;
+    if ((main_logical_width == 0 || main_logical_height == 0) && main_target.id != 0) {
+        UnloadRenderTexture(main_target);
+        main_target = RenderTexture2D{};
     }
-};
+}
 
-//--------------------------OBJ SPRITE SHEET-----------------------------------------
-/**
- * @class Obj_ss
- * @brief Represents a sprite sheet object, supporting static and animated tiles.
- * 
- * This class handles rendering static or animated tiles from a single sprite sheet.
- */
-class Obj_ss : public Obj {
-public:
-    int tile_width;         // Tile width
-    int tile_height;        // Tile height
-    int frame_count;        // Number of animation frames (optional)
-    float elapsed_time;     // Time accumulator for animations
-    int row_offset;         // Starting row offset
-
-    // Original constructor (default row_offset = 0)
-    Obj_ss(const std::string& path, int x_pos, int y_pos, float scale_factor, 
-           int t_width, int t_height, int frames = 1, float frame_duration = 1.0f)
-        : Obj(path, x_pos, y_pos, scale_factor, frame_duration),
-          tile_width(t_width), tile_height(t_height), frame_count(frames),
-          elapsed_time(0.0f), row_offset(0) {}
-
-    // Overloaded constructor with row offset parameter
-    Obj_ss(const std::string& path, int x_pos, int y_pos, float scale_factor, 
-           int t_width, int t_height, int frames, float frame_duration, int start_row)
-        : Obj(path, x_pos, y_pos, scale_factor, frame_duration),
-          tile_width(t_width), tile_height(t_height), frame_count(frames),
-          elapsed_time(0.0f), row_offset(start_row) {}
-
-    void render(float delta_time = 0.0f) {
-        if (textures.empty() || tile_width <= 0 || tile_height <= 0) return;
-
-        if (frame_count > 1) { // Handle animation if more than 1 frame
-            elapsed_time += delta_time;
-            if (elapsed_time >= frame_time) {
-                current_frame = (current_frame + 1) % frame_count;
-                elapsed_time = 0.0f;
-            }
-        }
+// Render into a target this fraction of the logical size (see ResolutionController)
+void set_render_scale(float scale) {
+    main_render_scale = scale < 0.1f ? 0.1f : (scale > 1.0f ? 1.0f : scale);
+}
 
-        const Texture2D& texture = textures[0];
-        int frames_per_row = texture.width / tile_width;
-
-        int tile_x = current_frame % frames_per_row;
-        int tile_y = (current_frame / frames_per_row) + row_offset; // Use row_offset here
-
-        Rectangle src = {
-            static_cast<float>(tile_x * tile_width),
-            static_cast<float>(tile_y * tile_height),
-            static_cast<float>(tile_width),
-            static_cast<float>(tile_height)
-        };
-        Rectangle dst = {
-            static_cast<float>(x),
-            static_cast<float>(y),
-            tile_width * scale,
-            tile_height * scale
-        };
-        DrawTexturePro(texture, src, dst, {0, 0}, 0.0f, WHITE);
-    }
-};
-//---------------------------------------- other func -------------------------------------------
+// Milliseconds from start_drawing to the end of the frame's draws, not counting the FPS wait in EndDrawing
+float last_frame_ms() {
+    return main_last_frame_ms;
+}
+
+// (Re)create the offscreen target when the logical size or render scale changed
+void update_render_target() {
+    int w = static_cast<int>(main_logical_width * main_render_scale + 0.5f);
+    int h = static_cast<int>(main_logical_height * main_render_scale + 0.5f);
+    if (w < 1) w = 1;
+    if (h < 1) h = 1;
+    if (main_target.id != 0 && w == main_target.texture.width && h == main_target.texture.height) return;
+
+    if (main_target.id != 0) UnloadRenderTexture(main_target);
+    main_target = LoadRenderTexture(w, h);
+    SetTextureFilter(main_target.texture, TEXTURE_FILTER_POINT);
+}
+
+//---------------------------------------- frame capture -------------------------------------------
+
+// PNG encoder for the capture thread
+bool write_png_rgba(const std::string& path, const uint8_t* rgba, int width, int height) {
+    Image image = {const_cast<uint8_t*>(rgba), width, height, 1, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8};
+    return ExportImage(image, path.c_str());
+}
+
+static FrameCapture main_capture(write_png_rgba);
+
+// Save the next presented frame as a PNG (written on a background thread)
+void screenshot(const std::string& path) {
+    main_capture.screenshot(path);
+}
+
+// Append every n-th presented frame to a raw RGBA file (see capture.hpp)
+bool start_video(const std::string& path, int every_nth_frame = 1) {
+    return main_capture.start_video(path, every_nth_frame);
+}
+
+void stop_video() {
+    main_capture.stop_video();
+}
+
+CaptureStats capture_stats() {
+    return main_capture.stats();
+}
+
+// Copy the finished frame out for the capture thread, if a screenshot or video wants it
+void capture_backbuffer() {
+    if (!main_capture.wants_frame()) return;
+    CaptureFrame* frame = main_capture.acquire(GetRenderWidth(), GetRenderHeight());
+    if (!frame) return;
+
+    double start = GetTime();
+    rlDrawRenderBatchActive();                  // Everything queued has to be in the framebuffer
+    Image image = LoadImageFromScreen();        // Top row first, RGBA
+    frame->width = image.width;
+    frame->height = image.height;
+    frame->pixels.resize(static_cast<size_t>(image.width) * image.height * 4);
+    if (image.data) std::memcpy(frame->pixels.data(), image.data, frame->pixels.size());
+    UnloadImage(image);
+    main_capture.submit(frame, (GetTime() - start) * 1000.0);
+}
 
  void init_window(int width, int height, const char* title, int target_fps){
     InitWindow(width, height, title);
     SetTargetFPS(target_fps);
  }
 
+// Anything the player did at the last input poll; reads key and button states without
+// emptying raylib's key queues, so GetKeyPressed still sees them
+bool input_seen() {
+    Vector2 delta = GetMouseDelta();
+    if (delta.x != 0 || delta.y != 0 || GetMouseWheelMove() != 0 || IsWindowResized()) return true;
+    for (int button = MOUSE_BUTTON_LEFT; button <= MOUSE_BUTTON_BACK; button++) {
+        if (IsMouseButtonPressed(button) || IsMouseButtonReleased(button)) return true;
+    }
+    for (int key = KEY_SPACE; key <= KEY_KB_MENU; key++) {
+        if (IsKeyPressed(key) || IsKeyReleased(key)) return true;
+#if defined(RAYLIB_VERSION_MAJOR) && RAYLIB_VERSION_MAJOR >= 5
+        if (IsKeyPressedRepeat(key)) return true;       // Held key repeating into the char queue
+#endif
+    }
+    return false;
+}
+
+// Mouse position in the coordinates the game draws in (logical ones after set_logical_resolution)
+void mouse_position(int& x, int& y) {
+    x = GetMouseX();
+    y = GetMouseY();
+    window_to_logical(GetScreenWidth(), GetScreenHeight(), main_logical_width, main_logical_height, x, y);
+}
+
+// Left mouse button held
+bool mouse_down() {
+    return IsMouseButtonDown(MOUSE_BUTTON_LEFT);
+}
+
+// In idle mode, sleep until input or a requested redraw before answering
  bool window_should_close() {
+     int wait = idle_wait_ms();
+     if (wait != 0 && input_seen()) {
+         // EndDrawing already polled and caught input: draw for it now, polling again would
+         // clear the pressed / released states and GetKeyPressed queue before the game reads them
+         mark_dirty();
+     } else if (wait < 0) {
+         // Nothing scheduled: block in glfwWaitEvents until something happens
+         EnableEventWaiting();
+         PollInputEvents();
+         DisableEventWaiting();
+         mark_dirty();
+     } else {
+         // A redraw is due later: sleep in short steps so input still wakes us up
+         while ((wait = idle_wait_ms()) > 0) {
+             WaitTime((wait < 16 ? wait : 16) / 1000.0);
+             PollInputEvents();
+             if (input_seen() || WindowShouldClose()) {
+                 mark_dirty();
+                 break;
+             }
+         }
+     }
      return WindowShouldClose();
  }
 void start_drawing(){
+	main_frame_start = GetTime();
 	BeginDrawing();
+	if (main_logical_width == 0) return;
+
+	update_render_target();
+	if (main_target.id == 0) return;
+	BeginTextureMode(main_target);
+	Camera2D camera = {{0, 0}, {0, 0}, 0.0f, static_cast<float>(main_target.texture.width) / main_logical_width};
+	BeginMode2D(camera);                // Logical coordinates onto a smaller target
+	main_target_active = true;
 }
 void stop_drawing(){
+	set_opaque_drawing(false);
+	if (main_target_active) {
+		// Scale the logical frame up to the window in one draw (render textures are stored upside down)
+		EndMode2D();
+		EndTextureMode();
+		int x, y, w, h;
+		fit_logical(GetScreenWidth(), GetScreenHeight(), main_logical_width, main_logical_height, x, y, w, h);
+		ClearBackground(BLACK);
+		Rectangle src = {0, 0, static_cast<float>(main_target.texture.width), -static_cast<float>(main_target.texture.height)};
+		Rectangle dst = {static_cast<float>(x), static_cast<float>(y), static_cast<float>(w), static_cast<float>(h)};
+		DrawTexturePro(main_target.texture, src, dst, {0, 0}, 0.0f, WHITE);
+		main_target_active = false;
+	}
+	main_last_frame_ms = static_cast<float>((GetTime() - main_frame_start) * 1000.0);
+	capture_backbuffer();
 	EndDrawing();
+	idle_frame_presented();
+	main_frame_arena.reset();
+	end_alloc_frame();
+	end_fill_frame();
 }
 // Set the background color
 void clear_screen(Color color) {
@@ -162,25 +224,275 @@ void clear_screen(Color color) {
 
 // Draw a rectangle
 void draw_rect(int x, int y, int width, int height, Color color) {
+    set_opaque_drawing(false);
     Color raylib_color = (Color){color.r, color.g, color.b, color.a};
     DrawRectangle(x, y, width, height, raylib_color);
 }
 
 // Draw a circle
 void draw_circle(int x, int y, int radius, Color color) {
+    set_opaque_drawing(false);
     Color raylib_color = (Color){color.r, color.g, color.b, color.a};
     DrawCircle(x, y, radius, raylib_color);
 }
 
 // Draw text using a font (make sure to load the font before calling this)
 void draw_text(const char* text, int x, int y, Color color) {
+    set_opaque_drawing(false);
     Color raylib_color = (Color){color.r, color.g, color.b, color.a};
     DrawText(text, x, y, 24, raylib_color);
 }
 
 void quit_window(){
+	main_capture.finish();
+	if (main_target.id != 0) UnloadRenderTexture(main_target);
+	main_target = RenderTexture2D{};
 	CloseWindow();
 }
+
+#include "core.hpp"
+#include "ui.hpp"
+#include "text.hpp"
+#include "sdf.hpp"
+
+//--------------------------BACKEND POLICY-------------------------------------------
+
+/**
+ * @struct RaylibBackend
+ * @brief Raylib side of the shared Obj / Obj_ss core (see core.hpp).
+ */
+struct RaylibBackend {
+    typedef Texture2D* Texture;     // Kept on the heap so handles (and Objs) move by pointer
+    typedef RenderTexture2D* Layer; // Render target for UiLayer (see ui.hpp)
+
+    static bool load_texture(const std::string& path, Texture& out, AlphaMap& alpha) {
+        Image image = LoadImage(path.c_str());
+        if (!image.data) return false;
+
+        // Read the alpha channel while the pixels are still on the CPU, and upload only the trimmed part
+        ImageFormat(&image, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8);
+        alpha.assign_rgba(static_cast<const uint8_t*>(image.data), image.width, image.height, image.width * 4);
+        if (alpha.trim()) {
+            ImageCrop(&image, Rectangle{static_cast<float>(alpha.offset_x), static_cast<float>(alpha.offset_y),
+                                        static_cast<float>(alpha.width), static_cast<float>(alpha.height)});
+        }
+
+        Texture2D texture = LoadTextureFromImage(image);
+        UnloadImage(image);
+        if (texture.id == 0) return false;
+        out = new Texture2D(texture);
+        return true;
+    }
+
+    static void unload_texture(Texture texture) {
+        UnloadTexture(*texture);
+        delete texture;
+    }
+
+    static void texture_size(Texture texture, int& width, int& height) {
+        width = texture->width;
+        height = texture->height;
+    }
+
+    static void draw_texture(Texture texture, const TexRect* src, const DrawRect& dst, bool opaque) {
+        set_opaque_drawing(opaque);
+        count_fill(dst.w, dst.h, opaque);
+        Rectangle src_rect = src
+            ? Rectangle{static_cast<float>(src->x), static_cast<float>(src->y),
+                        static_cast<float>(src->w), static_cast<float>(src->h)}
+            : Rectangle{0, 0, static_cast<float>(texture->width), static_cast<float>(texture->height)};
+        if (dst.flip & FLIP_HORIZONTAL) src_rect.width = -src_rect.width;     // Negative size flips
+        if (dst.flip & FLIP_VERTICAL) src_rect.height = -src_rect.height;
+        if (dst.angle == 0.0f) {
+            DrawTexturePro(*texture, src_rect, {dst.x, dst.y, dst.w, dst.h}, {0, 0}, 0.0f, WHITE);
+        } else {
+            // Rotate around the middle: dest is positioned at the origin, which is the center
+            Vector2 origin = {dst.w / 2, dst.h / 2};
+            DrawTexturePro(*texture, src_rect, {dst.x + origin.x, dst.y + origin.y, dst.w, dst.h}, origin, dst.angle, WHITE);
+        }
+    }
+
+    static bool load_font_atlas(const std::string& path, int size, Texture& out, FontMetrics& metrics) {
+        Font font = LoadFontEx(path.c_str(), size, nullptr, 95);     // ' ' to '~'
+        if (font.glyphs == nullptr || font.texture.id == GetFontDefault().texture.id) return false;
+        metrics.size = size;
+        metrics.line_height = static_cast<float>(font.baseSize);
+        for (int i = 0; i < 95; i++) {
+            metrics.glyphs[i] = AtlasGlyph{TexRect{0, 0, 0, 0}, 0.0f, 0.0f, static_cast<float>(size) / 2};
+        }
+        for (int i = 0; i < font.glyphCount; i++) {
+            int code = font.glyphs[i].value;
+            if (code < 32 || code > 126) continue;
+            const Rectangle& rec = font.recs[i];
+            AtlasGlyph& glyph = metrics.glyphs[code - 32];
+            glyph.src = TexRect{static_cast<int>(rec.x), static_cast<int>(rec.y),
+                                static_cast<int>(rec.width), static_cast<int>(rec.height)};
+            glyph.off_x = static_cast<float>(font.glyphs[i].offsetX);
+            glyph.off_y = static_cast<float>(font.glyphs[i].offsetY);
+            glyph.advance = static_cast<float>(font.glyphs[i].advanceX ? font.glyphs[i].advanceX : rec.width);
+            if (code == ' ') glyph.src.w = 0;
+        }
+
+        // Keep the atlas texture, free the rest of the font
+        out = new Texture2D(font.texture);
+        UnloadFontData(font.glyphs, font.glyphCount);
+        MemFree(font.recs);
+        return true;
+    }
+
+    // Glyphs of a font at one size, side by side in a CPU coverage atlas (one byte per texel)
+    static bool rasterize_font(const std::string& path, int size, std::vector<uint8_t>& coverage,
+                               int& width, int& height, FontMetrics& metrics) {
+        int file_size = 0;
+        unsigned char* data = LoadFileData(path.c_str(), &file_size);
+        if (!data) return false;
+        GlyphInfo* glyphs = LoadFontData(data, file_size, size, nullptr, 95, FONT_DEFAULT);    // ' ' to '~'
+        UnloadFileData(data);
+        if (!glyphs) return false;
+
+        metrics.size = size;
+        metrics.line_height = static_cast<float>(size);
+        width = 0;
+        height = 0;
+        for (int i = 0; i < 95; i++) {
+            width += glyphs[i].image.width + 1;
+            if (glyphs[i].image.height > height) height = glyphs[i].image.height;
+        }
+        coverage.assign(static_cast<size_t>(width) * height, 0);
+
+        int x = 0;
+        for (int i = 0; i < 95; i++) {
+            const Image& image = glyphs[i].image;      // Grayscale coverage
+            AtlasGlyph& glyph = metrics.glyphs[i];
+            glyph.src = TexRect{x, 0, i == 0 ? 0 : image.width, image.height};
+            glyph.off_x = static_cast<float>(glyphs[i].offsetX);
+            glyph.off_y = static_cast<float>(glyphs[i].offsetY);
+            glyph.advance = static_cast<float>(glyphs[i].advanceX ? glyphs[i].advanceX : image.width);
+            const uint8_t* pixels = static_cast<const uint8_t*>(image.data);
+            for (int row = 0; pixels && row < image.height; row++) {
+                std::copy(pixels + row * image.width, pixels + (row + 1) * image.width,
+                          &coverage[static_cast<size_t>(row) * width + x]);
+            }
+            x += image.width + 1;
+        }
+        UnloadFontData(glyphs, 95);
+        return true;
+    }
+
+    // Consecutive quads from one texture end up in a single rlgl batch
+    static void draw_glyphs(Texture atlas, const TextLayout& layout, float x, float y, Color color) {
+        set_opaque_drawing(false);
+        for (const GlyphQuad& quad : layout.quads) {
+            Rectangle src = {static_cast<float>(quad.src.x), static_cast<float>(quad.src.y),
+                             static_cast<float>(quad.src.w), static_cast<float>(quad.src.h)};
+            DrawTexturePro(*atlas, src, Rectangle{x + quad.x, y + quad.y, quad.w, quad.h}, {0, 0}, 0.0f, color);
+            count_fill(quad.w, quad.h, false);
+        }
+    }
+
+    // Distance field texture and the shader that cuts its edge
+    struct SdfField {
+        Texture2D texture;
+        Shader shader;
+    };
+    typedef SdfField* SdfAtlas;
+
+    static SdfAtlas create_sdf_atlas(const uint8_t* field, int width, int height, float) {
+        // One channel: the default shader reads it back as (d, d, d, 1)
+        Image image = {const_cast<uint8_t*>(field), width, height, 1, PIXELFORMAT_UNCOMPRESSED_GRAYSCALE};
+        Texture2D texture = LoadTextureFromImage(image);
+        if (texture.id == 0) return nullptr;
+        SetTextureFilter(texture, TEXTURE_FILTER_BILINEAR);
+
+        static const char* fragment =
+            "#version 330\n"
+            "in vec2 fragTexCoord;\n"
+            "in vec4 fragColor;\n"
+            "uniform sampler2D texture0;\n"
+            "uniform vec4 colDiffuse;\n"
+            "out vec4 finalColor;\n"
+            "void main() {\n"
+            "    float distance = texture(texture0, fragTexCoord).r;\n"
+            "    float smoothing = fwidth(distance) * 0.5;\n"         // About one screen pixel at any scale
+            "    float alpha = smoothstep(0.5 - smoothing, 0.5 + smoothing, distance);\n"
+            "    finalColor = vec4(fragColor.rgb, fragColor.a * alpha) * colDiffuse;\n"
+            "}\n";
+        return new SdfField{texture, LoadShaderFromMemory(nullptr, fragment)};
+    }
+
+    static void destroy_sdf_atlas(SdfAtlas atlas) {
+        UnloadShader(atlas->shader);
+        UnloadTexture(atlas->texture);
+        delete atlas;
+    }
+
+    static void draw_sdf_glyphs(SdfAtlas atlas, const TextLayout& layout, float x, float y, float scale, Color color) {
+        set_opaque_drawing(false);
+        BeginShaderMode(atlas->shader);
+        for (const GlyphQuad& quad : layout.quads) {
+            Rectangle src = {static_cast<float>(quad.src.x), static_cast<float>(quad.src.y),
+                             static_cast<float>(quad.src.w), static_cast<float>(quad.src.h)};
+            Rectangle dst = {x + quad.x * scale, y + quad.y * scale, quad.w * scale, quad.h * scale};
+            DrawTexturePro(atlas->texture, src, dst, {0, 0}, 0.0f, color);
+            count_fill(dst.width, dst.height, false);
+        }
+        EndShaderMode();
+    }
+
+    static Layer create_layer(int width, int height) {
+        RenderTexture2D layer = LoadRenderTexture(width, height);
+        if (layer.id == 0) return nullptr;
+        return new RenderTexture2D(layer);
+    }
+
+    static void destroy_layer(Layer layer) {
+        UnloadRenderTexture(*layer);
+        delete layer;
+    }
+
+    static void begin_layer(Layer layer) {
+        BeginTextureMode(*layer);
+        ClearBackground(BLANK);
+        // Plain alpha blending would square the alpha of soft edges on a transparent target
+        rlSetBlendFactorsSeparate(RL_SRC_ALPHA, RL_ONE_MINUS_SRC_ALPHA, RL_ONE, RL_ONE_MINUS_SRC_ALPHA,
+                                  RL_FUNC_ADD, RL_FUNC_ADD);
+        BeginBlendMode(BLEND_CUSTOM_SEPARATE);
+    }
+
+    static void end_layer(Layer) {
+        set_opaque_drawing(false);
+        EndBlendMode();
+        EndTextureMode();
+    }
+
+    static void draw_layer(Layer layer, int x, int y) {
+        set_opaque_drawing(false);
+        float w = static_cast<float>(layer->texture.width), h = static_cast<float>(layer->texture.height);
+        count_fill(w, h, false);
+        BeginBlendMode(BLEND_ALPHA_PREMULTIPLY);
+        // Render textures are stored upside down
+        DrawTextureRec(layer->texture, Rectangle{0, 0, w, -h}, Vector2{static_cast<float>(x), static_cast<float>(y)}, WHITE);
+        EndBlendMode();
+    }
+};
+
+//--------------------------OBJ----------------------------------------------------
+/**
+ * Obj: a general object rendered with a single sprite (e.g player.png) or animated from an array of sprite paths.
+ * Obj_ss: static or animated tiles from a single sprite sheet.
+ * Both are the shared core in core.hpp instantiated for raylib.
+ */
+typedef BasicObj<RaylibBackend> Obj;
+typedef BasicObj_ss<RaylibBackend> Obj_ss;
+typedef BasicUiLayer<RaylibBackend> UiLayer;
+typedef BasicTextFont<RaylibBackend> TextFont;
+typedef BasicSdfFont<RaylibBackend> SdfFont;
+
+// Issue the draw calls recorded in a command list (call on the render thread)
+void replay_commands(const CommandList& list) {
+    replay_commands_with<RaylibBackend>(list);
+}
+
 //------------------------------------------MAIN-----------------------------------------
 /**
  * @brief Main function demonstrating usage of static and animated sprite sheets.
@@ -6,7 +6,7 @@
 #include <stdexcept>
 #include <iostream>
 #include <stdint.h>
-#include"color.h"
+#include <unordered_map>
 
 //--------------------------GLOBAL VARIABLES-----------------------------------------
 
@@ -14,6 +14,13 @@ typedef struct {
     uint8_t r, g, b, a;
 } Color;
 
+#include"color.h"
+#include "arena.hpp"
+#include "alpha.hpp"
+#include "resolution.hpp"
+#include "idle.hpp"
+#include "capture.hpp"
+
 // Global SDL state
 static SDL_Window* main_window = NULL;
 static SDL_Renderer* main_renderer = NULL;
@@ -23,6 +30,220 @@ static Uint32 main_target_frame_time = 0;
 // Global font for text rendering
 static TTF_Font* main_font = NULL;
 
+// Scratch memory for the current frame, reset in stop_drawing
+static FrameArena main_frame_arena;
+
+//--------------------------RENDER STATE CACHE----------------------------------------
+
+/**
+ * @struct RenderState
+ * @brief Last state handed to the SDL renderer, so calls that wouldn't change anything are skipped.
+ *  Colors are kept packed (pack_color) so each check is a single integer compare.
+ */
+struct RenderState {
+    uint32_t draw_color;            // Packed SDL_SetRenderDrawColor value
+    bool draw_color_known;
+    SDL_BlendMode blend_mode;       // SDL_SetRenderDrawBlendMode value
+    bool blend_mode_known;
+    SDL_Rect clip;                  // Active clip rect (w == 0 means no clipping)
+    bool clip_known;
+    std::unordered_map<SDL_Texture*, uint32_t> texture_mods;   // Packed color + alpha mod per texture
+    std::unordered_map<SDL_Texture*, SDL_BlendMode> texture_blend;  // Blend mode per texture
+    size_t changes;                 // State calls passed through to SDL
+    size_t elided;                  // State calls skipped because nothing changed
+};
+
+static RenderState main_render_state = {};
+
+// Forget what the renderer is set to (after calling SDL directly or switching render target)
+void invalidate_render_state() {
+    main_render_state.draw_color_known = false;
+    main_render_state.blend_mode_known = false;
+    main_render_state.clip_known = false;
+}
+
+void set_draw_color(Color color) {
+    uint32_t packed = pack_color(color);
+    if (main_render_state.draw_color_known && main_render_state.draw_color == packed) {
+        main_render_state.elided++;
+        return;
+    }
+    SDL_SetRenderDrawColor(main_renderer, color.r, color.g, color.b, color.a);
+    main_render_state.draw_color = packed;
+    main_render_state.draw_color_known = true;
+    main_render_state.changes++;
+}
+
+void set_blend_mode(SDL_BlendMode mode) {
+    if (main_render_state.blend_mode_known && main_render_state.blend_mode == mode) {
+        main_render_state.elided++;
+        return;
+    }
+    SDL_SetRenderDrawBlendMode(main_renderer, mode);
+    main_render_state.blend_mode = mode;
+    main_render_state.blend_mode_known = true;
+    main_render_state.changes++;
+}
+
+// Restrict drawing to a rect, or pass NULL to draw everywhere
+void set_clip_rect(const SDL_Rect* rect) {
+    SDL_Rect next = rect ? *rect : SDL_Rect{0, 0, 0, 0};
+    const SDL_Rect& last = main_render_state.clip;
+    if (main_render_state.clip_known && last.x == next.x && last.y == next.y && last.w == next.w && last.h == next.h) {
+        main_render_state.elided++;
+        return;
+    }
+    SDL_RenderSetClipRect(main_renderer, rect);
+    main_render_state.clip = next;
+    main_render_state.clip_known = true;
+    main_render_state.changes++;
+}
+
+// Tint a texture (color mod) and set its alpha mod; textures start at COLOR_WHITE
+void set_texture_mod(SDL_Texture* texture, Color color) {
+    uint32_t packed = pack_color(color);
+    auto found = main_render_state.texture_mods.find(texture);
+    uint32_t current = found != main_render_state.texture_mods.end() ? found->second : 0xFFFFFFFFu;
+    if (current == packed) {
+        main_render_state.elided++;
+        return;
+    }
+    if ((current ^ packed) & 0xFFFFFF00u) {
+        SDL_SetTextureColorMod(texture, color.r, color.g, color.b);
+        main_render_state.changes++;
+    }
+    if ((current ^ packed) & 0xFFu) {
+        SDL_SetTextureAlphaMod(texture, color.a);
+        main_render_state.changes++;
+    }
+    main_render_state.texture_mods[texture] = packed;
+}
+
+// Blend mode a texture is copied with (SDL_BLENDMODE_NONE for opaque pixels)
+void set_texture_blend(SDL_Texture* texture, SDL_BlendMode mode) {
+    auto found = main_render_state.texture_blend.find(texture);
+    if (found != main_render_state.texture_blend.end() && found->second == mode) {
+        main_render_state.elided++;
+        return;
+    }
+    SDL_SetTextureBlendMode(texture, mode);
+    main_render_state.texture_blend[texture] = mode;
+    main_render_state.changes++;
+}
+
+// Number of renderer state calls skipped since start (or since the last reset)
+size_t render_state_elided() {
+    return main_render_state.elided;
+}
+
+size_t render_state_changes() {
+    return main_render_state.changes;
+}
+
+void reset_render_state_stats() {
+    main_render_state.elided = 0;
+    main_render_state.changes = 0;
+}
+
+//--------------------------LOGICAL RESOLUTION----------------------------------------
+
+static int main_logical_width = 0;          // Size the game draws in, 0 draws straight to the window
+static int main_logical_height = 0;
+static float main_render_scale = 1.0f;      // Offscreen target size as a fraction of the logical size
+static SDL_Texture* main_target = NULL;
+static int main_target_width = 0;
+static int main_target_height = 0;
+static Uint64 main_frame_start = 0;
+static float main_last_frame_ms = 0.0f;
+
+// Draw in a width x height space, scaled up to the window in stop_drawing; 0, 0 turns it off
+void set_logical_resolution(int width, int height) {
+    main_logical_width = width > 0 ? width : 0;
+    main_logical_height = height > 0 ? height : 0;
+    if (main_logical_width == 0 || main_logical_height == 0) {
+        if (main_target) SDL_DestroyTexture(main_target);
+        main_target = NULL;
+        main_target_width = main_target_height = 0;
+    }
+}
+
+// Render into a target this fraction of the logical size (see ResolutionController)
+void set_render_scale(float scale) {
+    main_render_scale = scale < 0.1f ? 0.1f : (scale > 1.0f ? 1.0f : scale);
+}
+
+// Milliseconds from start_drawing to the present of the last frame, not counting vsync or the FPS delay
+float last_frame_ms() {
+    return main_last_frame_ms;
+}
+
+// (Re)create the offscreen target when the logical size or render scale changed
+void update_render_target() {
+    int w = static_cast<int>(main_logical_width * main_render_scale + 0.5f);
+    int h = static_cast<int>(main_logical_height * main_render_scale + 0.5f);
+    if (w < 1) w = 1;
+    if (h < 1) h = 1;
+    if (main_target && w == main_target_width && h == main_target_height) return;
+
+    if (main_target) {
+        main_render_state.texture_blend.erase(main_target);
+        SDL_DestroyTexture(main_target);
+    }
+    main_target = SDL_CreateTexture(main_renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET, w, h);
+    if (!main_target) {
+        SDL_Log("Failed to create render target: %s", SDL_GetError());
+        return;
+    }
+    SDL_SetTextureScaleMode(main_target, SDL_ScaleModeNearest);
+    main_target_width = w;
+    main_target_height = h;
+}
+
+//--------------------------FRAME CAPTURE---------------------------------------------
+
+// PNG encoder for the capture thread
+bool write_png_rgba(const std::string& path, const uint8_t* rgba, int width, int height) {
+    SDL_Surface* surface = SDL_CreateRGBSurfaceWithFormatFrom(const_cast<uint8_t*>(rgba), width, height, 32,
+                                                              width * 4, SDL_PIXELFORMAT_RGBA32);
+    if (!surface) return false;
+    bool ok = IMG_SavePNG(surface, path.c_str()) == 0;
+    SDL_FreeSurface(surface);
+    return ok;
+}
+
+static FrameCapture main_capture(write_png_rgba);
+
+// Save the next presented frame as a PNG (written on a background thread)
+void screenshot(const std::string& path) {
+    main_capture.screenshot(path);
+}
+
+// Append every n-th presented frame to a raw RGBA file (see capture.hpp)
+bool start_video(const std::string& path, int every_nth_frame = 1) {
+    return main_capture.start_video(path, every_nth_frame);
+}
+
+void stop_video() {
+    main_capture.stop_video();
+}
+
+CaptureStats capture_stats() {
+    return main_capture.stats();
+}
+
+// Copy the finished back buffer out for the capture thread, if a screenshot or video wants it
+void capture_backbuffer() {
+    if (!main_capture.wants_frame()) return;
+    int w = 0, h = 0;
+    SDL_GetRendererOutputSize(main_renderer, &w, &h);
+    CaptureFrame* frame = main_capture.acquire(w, h);
+    if (!frame) return;
+
+    Uint64 start = SDL_GetPerformanceCounter();
+    SDL_RenderReadPixels(main_renderer, NULL, SDL_PIXELFORMAT_RGBA32, frame->pixels.data(), w * 4);
+    main_capture.submit(frame, (SDL_GetPerformanceCounter() - start) * 1000.0 / SDL_GetPerformanceFrequency());
+}
+
 //--------------------------UTILITY FUNCTIONS-----------------------------------------
 // Initialize the window, renderer, and font
 void init_window(int width, int height, const char *title, int target_fps) {
@@ -71,47 +292,83 @@ void init_window(int width, int height, const char *title, int target_fps) {
     }
 }
 
-// Check if the window should close
+void handle_event(const SDL_Event& event) {
+    if (event.type == SDL_QUIT) {
+        main_window_should_close = true;
+    }
+    mark_dirty();       // Any input or window event may change what is on screen
+}
+
+// Check if the window should close; in idle mode, first sleep until an event or a requested redraw
 bool window_should_close() {
     SDL_Event event;
+    int wait = idle_wait_ms();
+    if (wait != 0) {
+        if (SDL_WaitEventTimeout(&event, wait)) handle_event(event);
+        idle_wait_ms();                 // Marks the frame dirty if the wait ran out on a redraw
+    }
     while (SDL_PollEvent(&event)) {
-        if (event.type == SDL_QUIT) {
-            main_window_should_close = true;
-        }
+        handle_event(event);
     }
     return main_window_should_close;
 }
 
-// Begin drawing (optional setup, placeholder for future use)
+// Mouse position in the coordinates the game draws in (logical ones after set_logical_resolution)
+void mouse_position(int& x, int& y) {
+    SDL_GetMouseState(&x, &y);
+    if (main_logical_width == 0) return;
+    int win_w = 0, win_h = 0;
+    SDL_GetRendererOutputSize(main_renderer, &win_w, &win_h);
+    window_to_logical(win_w, win_h, main_logical_width, main_logical_height, x, y);
+}
+
+// Left mouse button held
+bool mouse_down() {
+    return (SDL_GetMouseState(NULL, NULL) & SDL_BUTTON_LMASK) != 0;
+}
+
+// Begin drawing, into the offscreen target when a logical resolution is set
 void start_drawing() {
-    // Placeholder to mimic Raylib's flow
+    main_frame_start = SDL_GetPerformanceCounter();
+    if (main_logical_width == 0) return;
+
+    update_render_target();
+    if (!main_target) return;
+    SDL_SetRenderTarget(main_renderer, main_target);
+    SDL_RenderSetScale(main_renderer,
+                       static_cast<float>(main_target_width) / main_logical_width,
+                       static_cast<float>(main_target_height) / main_logical_height);
+    invalidate_render_state();      // Switching target resets the clip rect
 }
 
 // Set the background color
 void clear_screen(Color color) {
-    SDL_SetRenderDrawColor(main_renderer, color.r, color.g, color.b, color.a);
+    set_draw_color(color);
     SDL_RenderClear(main_renderer);
 }
 
 // Draw a rectangle
 void draw_rect(int x, int y, int width, int height, Color color) {
-    SDL_SetRenderDrawColor(main_renderer, color.r, color.g, color.b, color.a);
+    set_draw_color(color);
     SDL_Rect rect = {x, y, width, height};
     SDL_RenderFillRect(main_renderer, &rect);
 }
 
 // Draw a circle
 void draw_circle(int x, int y, int radius, Color color) {
-    SDL_SetRenderDrawColor(main_renderer, color.r, color.g, color.b, color.a);
-    for (int w = 0; w < radius * 2; w++) {
-        for (int h = 0; h < radius * 2; h++) {
-            int dx = radius - w; // Horizontal offset
-            int dy = radius - h; // Vertical offset
-            if ((dx * dx + dy * dy) <= (radius * radius)) {
-                SDL_RenderDrawPoint(main_renderer, x + dx, y + dy);
-            }
-        }
+    if (radius <= 0) return;
+    set_draw_color(color);
+    // One span per row, collected in frame memory and submitted in one call
+    SDL_Rect* spans = main_frame_arena.alloc_array<SDL_Rect>(static_cast<size_t>(radius) * 2);
+    int count = 0;
+    int half = 0; // Half-width of the current row, widening then narrowing down the circle
+    for (int dy = radius; dy > -radius; dy--) {
+        while ((half + 1) * (half + 1) + dy * dy <= radius * radius) half++;
+        while (half * half + dy * dy > radius * radius) half--;
+        int left = half < radius ? half : radius - 1; // Same pixels as before: columns -radius+1 .. radius
+        spans[count++] = SDL_Rect{x - left, y + dy, left + half + 1, 1};
     }
+    SDL_RenderFillRects(main_renderer, spans, count);
 }
 
 // Draw text using the global font
@@ -131,7 +388,30 @@ void draw_text(const char *text, int x, int y, Color color) {
 
 // End drawing and present to the screen (with FPS delay)
 void stop_drawing() {
+    // Scale the logical frame up to the window in one copy
+    if (main_target && SDL_GetRenderTarget(main_renderer) == main_target) {
+        SDL_SetRenderTarget(main_renderer, NULL);
+        SDL_RenderSetScale(main_renderer, 1.0f, 1.0f);
+        invalidate_render_state();
+
+        int win_w = 0, win_h = 0;
+        SDL_GetRendererOutputSize(main_renderer, &win_w, &win_h);
+        SDL_Rect dst;
+        fit_logical(win_w, win_h, main_logical_width, main_logical_height, dst.x, dst.y, dst.w, dst.h);
+        set_draw_color(COLOR_BLACK);
+        SDL_RenderClear(main_renderer);
+        set_texture_blend(main_target, SDL_BLENDMODE_NONE);
+        SDL_RenderCopy(main_renderer, main_target, NULL, &dst);
+    }
+    main_last_frame_ms = static_cast<float>((SDL_GetPerformanceCounter() - main_frame_start) * 1000.0 /
+                                            SDL_GetPerformanceFrequency());
+
+    capture_backbuffer();
     SDL_RenderPresent(main_renderer);
+    idle_frame_presented();
+    main_frame_arena.reset();
+    end_alloc_frame();
+    end_fill_frame();
 
     // Delay to maintain FPS
     if (main_target_frame_time > 0) {
@@ -146,6 +426,9 @@ void stop_drawing() {
 
 // Close and clean up SDL and font
 void quit_window() {
+    main_capture.finish();
+    if (main_target) SDL_DestroyTexture(main_target);
+    main_target = NULL;
     if (main_font) TTF_CloseFont(main_font);
     if (main_renderer) SDL_DestroyRenderer(main_renderer);
     if (main_window) SDL_DestroyWindow(main_window);
@@ -153,133 +436,319 @@ void quit_window() {
     SDL_Quit();
 }
 
-//--------------------------CLASS OBJ--------------------------------------------------
+#include "core.hpp"
+#include "ui.hpp"
+#include "text.hpp"
+#include "sdf.hpp"
+
+//--------------------------BACKEND POLICY-------------------------------------------
 
 /**
- * @class Obj
- * @brief Represents a general object that can be rendered with static or animated textures.
+ * @struct SdlBackend
+ * @brief SDL side of the shared Obj / Obj_ss core (see core.hpp).
  */
-class Obj {
-public:
-    int x, y;                      // Position
-    float scale;                   // Scale for rendering
-    std::vector<SDL_Texture*> textures; // Textures (single or multiple for animation)
-    int current_frame;             // Current animation frame
-    float frame_time;              // Time per frame (defaults to 1.0f for static objects)
-    float elapsed_time;            // Time accumulator
-
-    Obj(const std::string& path, int x_pos, int y_pos, float scale_factor, float frame_duration = 1.0f)
-        : x(x_pos), y(y_pos), scale(scale_factor), current_frame(0), frame_time(frame_duration), elapsed_time(0.0f) {
-        SDL_Texture* texture = IMG_LoadTexture(main_renderer, path.c_str());
-        if (texture) {
-            textures.push_back(texture);
+struct SdlBackend {
+    typedef SDL_Texture* Texture;
+    typedef SDL_Texture* Layer;     // Render target texture for UiLayer (see ui.hpp)
+
+    static bool load_texture(const std::string& path, Texture& out, AlphaMap& alpha) {
+        SDL_Surface* loaded = IMG_Load(path.c_str());
+        if (!loaded) return false;
+
+        // Read the alpha channel while the pixels are still on the CPU, and upload only the trimmed part
+        SDL_Surface* rgba = SDL_ConvertSurfaceFormat(loaded, SDL_PIXELFORMAT_RGBA32, 0);
+        if (!rgba) {
+            out = SDL_CreateTextureFromSurface(main_renderer, loaded);
+            SDL_FreeSurface(loaded);
+            return out != nullptr;
+        }
+        SDL_FreeSurface(loaded);
+
+        uint8_t* pixels = static_cast<uint8_t*>(rgba->pixels);
+        alpha.assign_rgba(pixels, rgba->w, rgba->h, rgba->pitch);
+        alpha.trim();
+        SDL_Surface* trimmed = SDL_CreateRGBSurfaceWithFormatFrom(
+            pixels + alpha.offset_y * rgba->pitch + alpha.offset_x * 4,
+            alpha.width, alpha.height, 32, rgba->pitch, SDL_PIXELFORMAT_RGBA32);
+        out = trimmed ? SDL_CreateTextureFromSurface(main_renderer, trimmed) : nullptr;
+        if (trimmed) SDL_FreeSurface(trimmed);
+        SDL_FreeSurface(rgba);
+        return out != nullptr;
+    }
+
+    static void unload_texture(Texture texture) {
+        main_render_state.texture_mods.erase(texture);
+        main_render_state.texture_blend.erase(texture);
+        SDL_DestroyTexture(texture);
+    }
+
+    static void texture_size(Texture texture, int& width, int& height) {
+        SDL_QueryTexture(texture, nullptr, nullptr, &width, &height);
+    }
+
+    static void draw_texture(Texture texture, const TexRect* src, const DrawRect& dst, bool opaque) {
+        set_texture_blend(texture, opaque ? SDL_BLENDMODE_NONE : SDL_BLENDMODE_BLEND);
+        count_fill(dst.w, dst.h, opaque);
+        SDL_Rect src_rect;
+        if (src) src_rect = SDL_Rect{src->x, src->y, src->w, src->h};
+        SDL_Rect dst_rect = {
+            static_cast<int>(dst.x),
+            static_cast<int>(dst.y),
+            static_cast<int>(dst.w),
+            static_cast<int>(dst.h)
+        };
+        if (dst.angle == 0.0f && dst.flip == FLIP_NONE) {
+            SDL_RenderCopy(main_renderer, texture, src ? &src_rect : nullptr, &dst_rect);
         } else {
-            throw std::runtime_error("Failed to load texture: " + path);
+            // SDL's flip bits match Flip, and a null center turns around the middle of dst
+            SDL_RenderCopyEx(main_renderer, texture, src ? &src_rect : nullptr, &dst_rect,
+                             dst.angle, nullptr, static_cast<SDL_RendererFlip>(dst.flip));
         }
     }
 
-    Obj(const std::vector<std::string>& paths, int x_pos, int y_pos, float scale_factor, float frame_duration)
-        : x(x_pos), y(y_pos), scale(scale_factor), current_frame(0), frame_time(frame_duration), elapsed_time(0.0f) {
-        for (const auto& path : paths) {
-            SDL_Texture* texture = IMG_LoadTexture(main_renderer, path.c_str());
-            if (texture) {
-                textures.push_back(texture);
-            } else {
-                throw std::runtime_error("Failed to load texture: " + path);
+    // Glyphs of a font at one size packed into a CPU coverage atlas (one byte per texel)
+    static bool rasterize_font(const std::string& path, int size, std::vector<uint8_t>& coverage,
+                               int& width, int& height, FontMetrics& metrics) {
+        TTF_Font* font = TTF_OpenFont(path.c_str(), size);
+        if (!font) return false;
+        metrics.size = size;
+        metrics.line_height = static_cast<float>(TTF_FontLineSkip(font));
+
+        // Render each glyph once (full line height, so they all sit on the same baseline) and
+        // pack them into rows of a 512 px wide atlas
+        const int atlas_width = 512;
+        SDL_Surface* rendered[95] = {};
+        int x = 0, y = 0, row_height = 0;
+        for (int i = 0; i < 95; i++) {
+            AtlasGlyph& glyph = metrics.glyphs[i];
+            int advance = 0;
+            TTF_GlyphMetrics(font, static_cast<Uint16>(32 + i), NULL, NULL, NULL, NULL, &advance);
+            glyph.advance = static_cast<float>(advance);
+            glyph.off_x = glyph.off_y = 0.0f;
+            glyph.src = TexRect{0, 0, 0, 0};
+            if (i == 0) continue;       // Space has nothing to draw
+            SDL_Surface* surface = TTF_RenderGlyph_Blended(font, static_cast<Uint16>(32 + i), SDL_Color{255, 255, 255, 255});
+            if (!surface) continue;
+            rendered[i] = SDL_ConvertSurfaceFormat(surface, SDL_PIXELFORMAT_RGBA32, 0);
+            SDL_FreeSurface(surface);
+            if (!rendered[i]) continue;
+            if (x + rendered[i]->w > atlas_width) {
+                x = 0;
+                y += row_height + 1;
+                row_height = 0;
+            }
+            glyph.src = TexRect{x, y, rendered[i]->w, rendered[i]->h};
+            x += rendered[i]->w + 1;
+            if (rendered[i]->h > row_height) row_height = rendered[i]->h;
+        }
+        TTF_CloseFont(font);
+
+        width = atlas_width;
+        height = y + row_height;
+        coverage.assign(static_cast<size_t>(width) * height, 0);
+        for (int i = 0; i < 95; i++) {
+            if (!rendered[i]) continue;
+            const TexRect& src = metrics.glyphs[i].src;
+            for (int row = 0; row < src.h; row++) {
+                const uint8_t* in = static_cast<const uint8_t*>(rendered[i]->pixels) + row * rendered[i]->pitch;
+                uint8_t* out = &coverage[static_cast<size_t>(src.y + row) * width + src.x];
+                for (int col = 0; col < src.w; col++) out[col] = in[col * 4 + 3];
             }
+            SDL_FreeSurface(rendered[i]);
         }
+        return true;
     }
 
-    ~Obj() {
-        for (auto& texture : textures) {
-            SDL_DestroyTexture(texture);
+    // White texture with the given alpha, for glyph atlases
+    static Texture coverage_texture(const std::vector<uint8_t>& alpha, int width, int height) {
+        SDL_Surface* surface = SDL_CreateRGBSurfaceWithFormat(0, width, height, 32, SDL_PIXELFORMAT_RGBA32);
+        if (!surface) return nullptr;
+        for (int row = 0; row < height; row++) {
+            uint8_t* out = static_cast<uint8_t*>(surface->pixels) + row * surface->pitch;
+            const uint8_t* in = &alpha[static_cast<size_t>(row) * width];
+            for (int col = 0; col < width; col++) {
+                out[col * 4] = out[col * 4 + 1] = out[col * 4 + 2] = 255;
+                out[col * 4 + 3] = in[col];
+            }
         }
+        Texture texture = SDL_CreateTextureFromSurface(main_renderer, surface);
+        SDL_FreeSurface(surface);
+        return texture;
     }
 
-    void render(float delta_time = 0.0f) {
-        if (textures.empty()) return;
+    static bool load_font_atlas(const std::string& path, int size, Texture& out, FontMetrics& metrics) {
+        std::vector<uint8_t> coverage;
+        int width = 0, height = 0;
+        if (!rasterize_font(path, size, coverage, width, height, metrics)) return false;
+        out = coverage_texture(coverage, width, height);
+        return out != nullptr;
+    }
 
-        if (textures.size() > 1) {
-            elapsed_time += delta_time;
-            if (elapsed_time >= frame_time) {
-                current_frame = (current_frame + 1) % textures.size();
-                elapsed_time = 0.0f;
-            }
+    /**
+     * @brief All quads of a layout in one SDL_RenderGeometry call, tinted through the vertex colors.
+     *  Quad rects are multiplied by scale; texture coords are src over (atlas_w, atlas_h), so a
+     *  texture of any size laid out like the atlas can stand in for it.
+     */
+    static void draw_glyph_quads(Texture texture, float atlas_w, float atlas_h, const TextLayout& layout,
+                                 float x, float y, float scale, Color color) {
+        float du = 1.0f / atlas_w, dv = 1.0f / atlas_h;
+        SDL_Color tint = {color.r, color.g, color.b, color.a};
+
+        size_t count = layout.quads.size();
+        SDL_Vertex* vertices = main_frame_arena.alloc_array<SDL_Vertex>(count * 4);
+        int* indices = main_frame_arena.alloc_array<int>(count * 6);
+        for (size_t i = 0; i < count; i++) {
+            const GlyphQuad& quad = layout.quads[i];
+            float x0 = x + quad.x * scale, y0 = y + quad.y * scale;
+            float x1 = x0 + quad.w * scale, y1 = y0 + quad.h * scale;
+            float u0 = quad.src.x * du, v0 = quad.src.y * dv;
+            float u1 = (quad.src.x + quad.src.w) * du, v1 = (quad.src.y + quad.src.h) * dv;
+            SDL_Vertex* v = &vertices[i * 4];
+            v[0] = SDL_Vertex{SDL_FPoint{x0, y0}, tint, SDL_FPoint{u0, v0}};
+            v[1] = SDL_Vertex{SDL_FPoint{x1, y0}, tint, SDL_FPoint{u1, v0}};
+            v[2] = SDL_Vertex{SDL_FPoint{x1, y1}, tint, SDL_FPoint{u1, v1}};
+            v[3] = SDL_Vertex{SDL_FPoint{x0, y1}, tint, SDL_FPoint{u0, v1}};
+            int base = static_cast<int>(i * 4);
+            int* index = &indices[i * 6];
+            index[0] = base; index[1] = base + 1; index[2] = base + 2;
+            index[3] = base; index[4] = base + 2; index[5] = base + 3;
+            count_fill(x1 - x0, y1 - y0, false);
         }
+        set_texture_blend(texture, SDL_BLENDMODE_BLEND);
+        SDL_RenderGeometry(main_renderer, texture, vertices, static_cast<int>(count * 4),
+                           indices, static_cast<int>(count * 6));
+    }
+
+    static void draw_glyphs(Texture atlas, const TextLayout& layout, float x, float y, Color color) {
+        int atlas_w = 1, atlas_h = 1;
+        SDL_QueryTexture(atlas, nullptr, nullptr, &atlas_w, &atlas_h);
+        draw_glyph_quads(atlas, static_cast<float>(atlas_w), static_cast<float>(atlas_h), layout, x, y, 1.0f, color);
+    }
 
-        SDL_Texture* texture = textures[current_frame];
+    // Distance field kept on the CPU and resolved into coverage textures, since SDL_Renderer
+    // has no shaders. Sizes are resolved in quarter-octave steps and each draw uses the nearest
+    // step at or above its scale, filtered down; a zoom only resolves a new texture every ~19%.
+    struct SdfSize {
+        int level;                  // Resolved at 2^(level / 4) times the atlas size
+        SDL_Texture* texture;
+        uint64_t last_used;
+    };
+    struct SdfField {
+        std::vector<uint8_t> field;
         int width, height;
-        SDL_QueryTexture(texture, nullptr, nullptr, &width, &height);
-        SDL_Rect dst = {
-            x,
-            y,
-            static_cast<int>(width * scale),
-            static_cast<int>(height * scale)
-        };
-        SDL_RenderCopy(main_renderer, texture, nullptr, &dst);
+        float spread;
+        std::vector<SdfSize> sizes;     // At most SDF_SIZES, least recently used goes first
+        uint64_t draws;
+    };
+    typedef SdfField* SdfAtlas;
+
+    static const int SDF_SIZES = 6;
+    static const int SDF_MIN_LEVEL = -16;      // 1/16 of the atlas
+    static const int SDF_MAX_SIDE = 4096;      // Larger scales are magnified from this
+
+    static SdfAtlas create_sdf_atlas(const uint8_t* field, int width, int height, float spread) {
+        SdfField* atlas = new SdfField();
+        atlas->field.assign(field, field + static_cast<size_t>(width) * height);
+        atlas->width = width;
+        atlas->height = height;
+        atlas->spread = spread;
+        atlas->draws = 0;
+        return atlas;
     }
-};
 
-//--------------------------CLASS OBJ_SPRITE SHEET-----------------------------------
+    static void destroy_sdf_atlas(SdfAtlas atlas) {
+        for (SdfSize& size : atlas->sizes) unload_texture(size.texture);
+        delete atlas;
+    }
 
-/**
- * @class Obj_ss
- * @brief Represents a sprite sheet object, supporting static and animated tiles.
- */
-class Obj_ss : public Obj {
-public:
-    int tile_width;         // Tile width
-    int tile_height;        // Tile height
-    int frame_count;        // Number of animation frames
-    int row_offset;         // Starting row offset
-
-    // Original constructor (default row_offset = 0)
-    Obj_ss(const std::string& path, int x_pos, int y_pos, float scale_factor, 
-           int t_width, int t_height, int frames = 1, float frame_duration = 1.0f)
-        : Obj(path, x_pos, y_pos, scale_factor, frame_duration),
-          tile_width(t_width), tile_height(t_height), frame_count(frames), row_offset(0) {}
-
-    // Overloaded constructor with row offset parameter
-    Obj_ss(const std::string& path, int x_pos, int y_pos, float scale_factor, 
-           int t_width, int t_height, int frames, float frame_duration, int start_row)
-        : Obj(path, x_pos, y_pos, scale_factor, frame_duration),
-          tile_width(t_width), tile_height(t_height), frame_count(frames), row_offset(start_row) {}
-
-    void render(float delta_time = 0.0f) {
-        if (textures.empty() || tile_width <= 0 || tile_height <= 0) return;
-
-        if (frame_count > 1) {
-            elapsed_time += delta_time;
-            if (elapsed_time >= frame_time) {
-                current_frame = (current_frame + 1) % frame_count;
-                elapsed_time = 0.0f;
+    static void draw_sdf_glyphs(SdfAtlas atlas, const TextLayout& layout, float x, float y, float scale, Color color) {
+        if (scale <= 0.0f) return;
+        int level = static_cast<int>(std::ceil(std::log2(scale) * 4.0f - 0.001f));
+        int side = atlas->width > atlas->height ? atlas->width : atlas->height;
+        int max_level = static_cast<int>(std::floor(std::log2(static_cast<float>(SDF_MAX_SIDE) / side) * 4.0f));
+        if (level > max_level) level = max_level;
+        if (level < SDF_MIN_LEVEL) level = SDF_MIN_LEVEL;
+
+        atlas->draws++;
+        SdfSize* found = nullptr;
+        for (SdfSize& size : atlas->sizes) {
+            if (size.level == level) found = &size;
+        }
+        if (!found) {
+            std::vector<uint8_t> coverage;
+            int width = 0, height = 0;
+            sdf_coverage(atlas->field.data(), atlas->width, atlas->height, atlas->spread,
+                         std::exp2(level / 4.0f), coverage, width, height);
+            SDL_Texture* texture = coverage_texture(coverage, width, height);
+            if (!texture) return;
+            SDL_SetTextureScaleMode(texture, SDL_ScaleModeLinear);
+            if (static_cast<int>(atlas->sizes.size()) >= SDF_SIZES) {
+                SdfSize* oldest = &atlas->sizes[0];
+                for (SdfSize& size : atlas->sizes) {
+                    if (size.last_used < oldest->last_used) oldest = &size;
+                }
+                unload_texture(oldest->texture);
+                *oldest = SdfSize{level, texture, 0};
+                found = oldest;
+            } else {
+                atlas->sizes.push_back(SdfSize{level, texture, 0});
+                found = &atlas->sizes.back();
             }
         }
+        found->last_used = atlas->draws;
+        draw_glyph_quads(found->texture, static_cast<float>(atlas->width), static_cast<float>(atlas->height),
+                         layout, x, y, scale, color);
+    }
 
-        SDL_Texture* texture = textures[0];
-        int width, height;
-        SDL_QueryTexture(texture, nullptr, nullptr, &width, &height);
-        int frames_per_row = width / tile_width;
+    static Layer create_layer(int width, int height) {
+        SDL_Texture* layer = SDL_CreateTexture(main_renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET,
+                                               width, height);
+        if (!layer) SDL_Log("Failed to create UI layer: %s", SDL_GetError());
+        return layer;
+    }
 
-        int tile_x = current_frame % frames_per_row;
-        int tile_y = (current_frame / frames_per_row) + row_offset; // Use row_offset here
+    static void destroy_layer(Layer layer) {
+        unload_texture(layer);
+    }
 
-        SDL_Rect src = {
-            tile_x * tile_width,
-            tile_y * tile_height,
-            tile_width,
-            tile_height
-        };
-        SDL_Rect dst = {
-            x,
-            y,
-            static_cast<int>(tile_width * scale),
-            static_cast<int>(tile_height * scale)
-        };
-        SDL_RenderCopy(main_renderer, texture, &src, &dst);
+    static void begin_layer(Layer layer) {
+        SDL_SetRenderTarget(main_renderer, layer);
+        invalidate_render_state();
+        set_draw_color(Color{0, 0, 0, 0});
+        SDL_RenderClear(main_renderer);
+    }
+
+    static void end_layer(Layer) {
+        SDL_SetRenderTarget(main_renderer, NULL);
+        invalidate_render_state();
+    }
+
+    static void draw_layer(Layer layer, int x, int y) {
+        // The layer's colors are already multiplied by alpha
+        static const SDL_BlendMode premultiplied = SDL_ComposeCustomBlendMode(
+            SDL_BLENDFACTOR_ONE, SDL_BLENDFACTOR_ONE_MINUS_SRC_ALPHA, SDL_BLENDOPERATION_ADD,
+            SDL_BLENDFACTOR_ONE, SDL_BLENDFACTOR_ONE_MINUS_SRC_ALPHA, SDL_BLENDOPERATION_ADD);
+        int w = 0, h = 0;
+        SDL_QueryTexture(layer, nullptr, nullptr, &w, &h);
+        set_texture_blend(layer, premultiplied);
+        count_fill(static_cast<float>(w), static_cast<float>(h), false);
+        SDL_Rect dst = {x, y, w, h};
+        SDL_RenderCopy(main_renderer, layer, NULL, &dst);
     }
 };
 
+//--------------------------CLASS OBJ--------------------------------------------------
+
+typedef BasicObj<SdlBackend> Obj;
+typedef BasicObj_ss<SdlBackend> Obj_ss;
+typedef BasicUiLayer<SdlBackend> UiLayer;
+typedef BasicTextFont<SdlBackend> TextFont;
+typedef BasicSdfFont<SdlBackend> SdfFont;
+
+// Issue the draw calls recorded in a command list (call on the render thread)
+void replay_commands(const CommandList& list) {
+    replay_commands_with<SdlBackend>(list);
+}
 
 //--------------------------MAIN-----------------------------------------------------
 // 
@@ -297,6 +766,7 @@ public:
 //         "img/player/Idle/3.png"
 //     };
 //     Obj animated_sprite(idle_frames, 300, 300, 2.0f, 0.2f);
+//     animated_sprite.flip = FLIP_HORIZONTAL; // Facing left with the same frames
 // 
 //     while (!window_should_close()) {
 //         float delta_time = 1.0f / 60.0f; // Simulate frame time
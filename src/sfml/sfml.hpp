@@ -6,7 +6,8 @@
 #include <stdexcept>
 #include <iostream>
 #include <cstdint>
-#include"color.h"
+#include <cmath>
+#include <cstring>
 //--------------------------GLOBAL VARIABLES-----------------------------------------
 
 // Global SFML state
@@ -18,6 +19,214 @@ struct Color {
     uint8_t r, g, b, a;
 };
 
+#include"color.h"
+#include "arena.hpp"
+#include "alpha.hpp"
+#include "resolution.hpp"
+#include "idle.hpp"
+#include "capture.hpp"
+
+// Scratch memory for the current frame, reset in stop_drawing
+static FrameArena main_frame_arena;
+
+//--------------------------LOGICAL RESOLUTION----------------------------------------
+
+static int main_logical_width = 0;          // Size the game draws in, 0 draws straight to the window
+static int main_logical_height = 0;
+static float main_render_scale = 1.0f;      // Offscreen target size as a fraction of the logical size
+static sf::RenderTexture main_target;
+static sf::Vector2u main_target_size(0, 0);
+static bool main_target_active = false;     // Drawing into main_target this frame
+static sf::Clock main_frame_clock;
+static float main_last_frame_ms = 0.0f;
+static sf::RenderTexture* main_layer_target = nullptr;     // UiLayer being redrawn, if any
+
+// Draw in a width x height space, scaled up to the window in stop_drawing; 0, 0 turns it off
+void set_logical_resolution(int width, int height) {
+    main_logical_width = width > 0 ? width : 0;
+    main_logical_height = height > 0 ? height : 0;
+}
+
+// Render into a target this fraction of the logical size (see ResolutionController)
+void set_render_scale(float scale) {
+    main_render_scale = scale < 0.1f ? 0.1f : (scale > 1.0f ? 1.0f : scale);
+}
+
+// Milliseconds from start_drawing to the display of the last frame, not counting the frame limiter
+float last_frame_ms() {
+    return main_last_frame_ms;
+}
+
+// Where draws go this frame: the offscreen target or the window
+sf::RenderTarget& main_surface() {
+    if (main_layer_target) return *main_layer_target;
+    if (main_target_active) return main_target;
+    return main_window;
+}
+
+// (Re)create the offscreen target when the logical size or render scale changed
+bool update_render_target() {
+    unsigned w = static_cast<unsigned>(main_logical_width * main_render_scale + 0.5f);
+    unsigned h = static_cast<unsigned>(main_logical_height * main_render_scale + 0.5f);
+    if (w < 1) w = 1;
+    if (h < 1) h = 1;
+    if (w == main_target_size.x && h == main_target_size.y) return true;
+
+    if (!main_target.create(w, h)) {
+        main_target_size = sf::Vector2u(0, 0);
+        return false;
+    }
+    main_target.setSmooth(false);
+    // The view keeps drawing in logical coordinates whatever the target's size
+    main_target.setView(sf::View(sf::FloatRect(0, 0, main_logical_width, main_logical_height)));
+    main_target_size = sf::Vector2u(w, h);
+    return true;
+}
+
+//--------------------------FRAME CAPTURE---------------------------------------------
+
+// PNG encoder for the capture thread
+bool write_png_rgba(const std::string& path, const uint8_t* rgba, int width, int height) {
+    sf::Image image;
+    image.create(width, height, rgba);
+    return image.saveToFile(path);
+}
+
+static FrameCapture main_capture(write_png_rgba);
+static sf::Texture main_capture_texture;    // Window contents are copied through this
+
+// Save the next presented frame as a PNG (written on a background thread)
+void screenshot(const std::string& path) {
+    main_capture.screenshot(path);
+}
+
+// Append every n-th presented frame to a raw RGBA file (see capture.hpp)
+bool start_video(const std::string& path, int every_nth_frame = 1) {
+    return main_capture.start_video(path, every_nth_frame);
+}
+
+void stop_video() {
+    main_capture.stop_video();
+}
+
+CaptureStats capture_stats() {
+    return main_capture.stats();
+}
+
+// Copy the finished frame out for the capture thread, if a screenshot or video wants it
+void capture_backbuffer() {
+    if (!main_capture.wants_frame()) return;
+    sf::Vector2u size = main_window.getSize();
+    CaptureFrame* frame = main_capture.acquire(size.x, size.y);
+    if (!frame) return;
+
+    sf::Clock clock;
+    if (main_capture_texture.getSize() != size) main_capture_texture.create(size.x, size.y);
+    main_capture_texture.update(main_window);
+    sf::Image image = main_capture_texture.copyToImage();     // Top row first, RGBA
+    std::memcpy(frame->pixels.data(), image.getPixelsPtr(), frame->pixels.size());
+    main_capture.submit(frame, clock.getElapsedTime().asSeconds() * 1000.0);
+}
+
+//--------------------------BATCHING-------------------------------------------------
+
+/**
+ * @struct SfmlBatch
+ * @brief Triangles waiting to be drawn with one texture (or none, for rects and circles).
+ *  Opaque pixels of a texture get their own batch, drawn with blending off.
+ *
+ * By default a draw with a different texture flushes what is pending, so call order is kept and
+ * consecutive draws of one texture (a tilemap, an effect pool, a sorted command list) become one draw.
+ * With set_batch_grouping(true) every texture keeps its own batch until the flush, one draw per
+ * texture per frame, for scenes where draws of different textures don't overlap.
+ */
+struct SfmlBatch {
+    const sf::Texture* texture;
+    bool opaque;                    // Drawn with sf::BlendNone
+    sf::VertexArray vertices;
+};
+
+static std::vector<SfmlBatch> main_batches;    // Kept between frames so vertex storage is reused
+static size_t main_batch_open = 0;              // Batches in use, in first-use order
+static bool main_batch_grouping = false;
+static size_t main_draw_calls = 0;              // Draws issued this frame
+static size_t main_last_draw_calls = 0;
+
+void set_batch_grouping(bool group_by_texture) {
+    main_batch_grouping = group_by_texture;
+}
+
+// Draws the last finished frame took
+size_t last_draw_calls() {
+    return main_last_draw_calls;
+}
+
+// Draw everything pending
+void flush_batches() {
+    for (size_t i = 0; i < main_batch_open; i++) {
+        SfmlBatch& batch = main_batches[i];
+        if (batch.vertices.getVertexCount() == 0) continue;
+        sf::RenderStates states(batch.opaque ? sf::BlendNone : sf::BlendAlpha);
+        states.texture = batch.texture;
+        main_surface().draw(batch.vertices, states);
+        main_draw_calls++;
+        batch.vertices.clear();
+    }
+    main_batch_open = 0;
+}
+
+// Drop everything pending (it would be cleared over anyway)
+void discard_batches() {
+    for (size_t i = 0; i < main_batch_open; i++) main_batches[i].vertices.clear();
+    main_batch_open = 0;
+}
+
+sf::VertexArray& batch_for(const sf::Texture* texture, bool opaque = false) {
+    if (main_batch_open > 0) {
+        SfmlBatch& last = main_batches[main_batch_open - 1];
+        if (last.texture == texture && last.opaque == opaque) return last.vertices;
+    }
+    if (main_batch_grouping) {
+        for (size_t i = 0; i < main_batch_open; i++) {
+            if (main_batches[i].texture == texture && main_batches[i].opaque == opaque) return main_batches[i].vertices;
+        }
+    } else {
+        flush_batches();
+    }
+    if (main_batch_open == main_batches.size()) {
+        main_batches.push_back(SfmlBatch{nullptr, false, sf::VertexArray(sf::Triangles)});
+    }
+    SfmlBatch& batch = main_batches[main_batch_open++];
+    batch.texture = texture;
+    batch.opaque = opaque;
+    batch.vertices.clear();
+    return batch.vertices;
+}
+
+// Two triangles covering (x, y, w, h) turned angle degrees clockwise around its center,
+// texture coords (u0, v0)-(u1, v1) in pixels (swap them to flip)
+void batch_quad(sf::VertexArray& vertices, float x, float y, float w, float h, sf::Color color,
+                float u0 = 0, float v0 = 0, float u1 = 0, float v1 = 0, float angle = 0) {
+    sf::Vector2f corners[4] = {
+        sf::Vector2f(x, y), sf::Vector2f(x + w, y), sf::Vector2f(x + w, y + h), sf::Vector2f(x, y + h)
+    };
+    if (angle != 0) {
+        float radians = angle * 3.14159265f / 180.0f;
+        float c = std::cos(radians), s = std::sin(radians);
+        float cx = x + w / 2, cy = y + h / 2;
+        for (sf::Vector2f& p : corners) {
+            float dx = p.x - cx, dy = p.y - cy;
+            p = sf::Vector2f(cx + dx * c - dy * s, cy + dx * s + dy * c);
+        }
+    }
+    sf::Vertex tl(corners[0], color, sf::Vector2f(u0, v0));
+    sf::Vertex tr(corners[1], color, sf::Vector2f(u1, v0));
+    sf::Vertex br(corners[2], color, sf::Vector2f(u1, v1));
+    sf::Vertex bl(corners[3], color, sf::Vector2f(u0, v1));
+    vertices.append(tl); vertices.append(tr); vertices.append(br);
+    vertices.append(tl); vertices.append(br); vertices.append(bl);
+}
+
 //--------------------------UTILITY FUNCTIONS-----------------------------------------
 
 // Initialize the window and font
@@ -30,164 +239,345 @@ void init_window(int width, int height, const char* title, int target_fps) {
     }
 }
 
-// Check if the window should close
+void handle_event(const sf::Event& event) {
+    if (event.type == sf::Event::Closed) {
+        main_window_should_close = true;
+    }
+    mark_dirty();       // Any input or window event may change what is on screen
+}
+
+// Mouse position in the coordinates the game draws in (logical ones after set_logical_resolution)
+void mouse_position(int& x, int& y) {
+    sf::Vector2i position = sf::Mouse::getPosition(main_window);
+    x = position.x;
+    y = position.y;
+    window_to_logical(main_window.getSize().x, main_window.getSize().y, main_logical_width, main_logical_height, x, y);
+}
+
+// Left mouse button held
+bool mouse_down() {
+    return sf::Mouse::isButtonPressed(sf::Mouse::Left);
+}
+
+// Check if the window should close; in idle mode, first sleep until an event or a requested redraw
 bool window_should_close() {
     sf::Event event;
-    while (main_window.pollEvent(event)) {
-        if (event.type == sf::Event::Closed) {
-            main_window_should_close = true;
+    int wait = idle_wait_ms();
+    if (wait < 0) {
+        if (main_window.waitEvent(event)) handle_event(event);
+    } else {
+        // sf::Window has no timed wait: sleep in short steps so input still wakes us up
+        while ((wait = idle_wait_ms()) > 0) {
+            if (main_window.pollEvent(event)) {
+                handle_event(event);
+                break;
+            }
+            sf::sleep(sf::milliseconds(wait < 10 ? wait : 10));
         }
     }
+    while (main_window.pollEvent(event)) {
+        handle_event(event);
+    }
     return main_window_should_close;
 }
 
-// Begin drawing (optional setup, placeholder for future use)
+// Begin drawing, into the offscreen target when a logical resolution is set
 void start_drawing() {
-    // Placeholder to mimic Raylib's flow
+    main_frame_clock.restart();
+    main_target_active = main_logical_width > 0 && main_logical_height > 0 && update_render_target();
 }
 
 // Set the background color
 void clear_screen(Color color) {
-    main_window.clear(sf::Color(color.r, color.g, color.b, color.a));
+    discard_batches();
+    main_surface().clear(sf::Color(color.r, color.g, color.b, color.a));
 }
 
 // Draw a rectangle
 void draw_rect(int x, int y, int width, int height, Color color) {
-    sf::RectangleShape rect(sf::Vector2f(width, height));
-    rect.setPosition(x, y);
-    rect.setFillColor(sf::Color(color.r, color.g, color.b, color.a));
-    main_window.draw(rect);
+    batch_quad(batch_for(nullptr), x, y, width, height, sf::Color(color.r, color.g, color.b, color.a));
 }
 
 // Draw a circle
 void draw_circle(int x, int y, int radius, Color color) {
-    sf::CircleShape circle(radius);
-    circle.setPosition(x - radius, y - radius);
-    circle.setFillColor(sf::Color(color.r, color.g, color.b, color.a));
-    main_window.draw(circle);
+    if (radius <= 0) return;
+    const int segments = 30;            // Same as sf::CircleShape's default
+    static float unit_x[segments + 1], unit_y[segments + 1];
+    static bool unit_ready = false;
+    if (!unit_ready) {
+        for (int i = 0; i <= segments; i++) {
+            float angle = i * 2.0f * 3.14159265f / segments;
+            unit_x[i] = std::cos(angle);
+            unit_y[i] = std::sin(angle);
+        }
+        unit_ready = true;
+    }
+
+    sf::VertexArray& vertices = batch_for(nullptr);
+    sf::Color fill(color.r, color.g, color.b, color.a);
+    sf::Vertex center(sf::Vector2f(x, y), fill);
+    for (int i = 0; i < segments; i++) {
+        vertices.append(center);
+        vertices.append(sf::Vertex(sf::Vector2f(x + unit_x[i] * radius, y + unit_y[i] * radius), fill));
+        vertices.append(sf::Vertex(sf::Vector2f(x + unit_x[i + 1] * radius, y + unit_y[i + 1] * radius), fill));
+    }
 }
 
-// Draw text using the global font
+// Draw text using the global font (drawn straight away, so pending batches go first)
 void draw_text(const char* text, int x, int y, Color color) {
+    flush_batches();
     sf::Text sf_text(text, main_font, 24);
     sf_text.setPosition(x, y);
     sf_text.setFillColor(sf::Color(color.r, color.g, color.b, color.a));
-    main_window.draw(sf_text);
+    main_surface().draw(sf_text);
+    main_draw_calls++;
 }
 
 // End drawing and present to the screen
 void stop_drawing() {
+    flush_batches();
+    if (main_target_active) {
+        // Scale the logical frame up to the window in one draw
+        main_target.display();
+        main_target_active = false;
+        int x, y, w, h;
+        fit_logical(main_window.getSize().x, main_window.getSize().y, main_logical_width, main_logical_height, x, y, w, h);
+        sf::Sprite frame;
+        frame.setTexture(main_target.getTexture(), true);
+        frame.setPosition(x, y);
+        frame.setScale(static_cast<float>(w) / main_target_size.x, static_cast<float>(h) / main_target_size.y);
+        main_window.clear(sf::Color::Black);
+        main_window.draw(frame, sf::RenderStates(sf::BlendNone));
+        main_draw_calls++;
+    }
+    main_last_draw_calls = main_draw_calls;
+    main_draw_calls = 0;
+    main_last_frame_ms = main_frame_clock.getElapsedTime().asSeconds() * 1000.0f;
+    capture_backbuffer();
     main_window.display();
+    idle_frame_presented();
+    main_frame_arena.reset();
+    end_alloc_frame();
+    end_fill_frame();
 }
 
 // Close and clean up
 void quit_window() {
+    main_capture.finish();
     main_window.close();
 }
 
-//--------------------------CLASS OBJ--------------------------------------------------
+#include "core.hpp"
+#include "ui.hpp"
+#include "text.hpp"
+#include "sdf.hpp"
+
+//--------------------------BACKEND POLICY-------------------------------------------
 
 /**
- * @class Obj
- * @brief Represents a general object that can be rendered with static or animated textures.
+ * @struct SfmlBackend
+ * @brief SFML side of the shared Obj / Obj_ss core (see core.hpp).
  */
-class Obj {
-public:
-    int x, y;                        // Position
-    float scale;                     // Scale for rendering
-    std::vector<sf::Texture> textures; // Textures (single or multiple for animation)
-    int current_frame;               // Current animation frame
-    float frame_time;                // Time per frame (defaults to 1.0f for static objects)
-    float elapsed_time;              // Time accumulator
-    sf::Sprite sprite;               // Sprite for rendering
-
-    Obj(const std::string& path, int x_pos, int y_pos, float scale_factor, float frame_duration = 1.0f)
-        : x(x_pos), y(y_pos), scale(scale_factor), current_frame(0), frame_time(frame_duration), elapsed_time(0.0f) {
-        sf::Texture texture;
-        if (!texture.loadFromFile(path)) {
-            throw std::runtime_error("Failed to load texture: " + path);
+struct SfmlBackend {
+    typedef sf::Texture* Texture;   // Kept on the heap, sf::Texture copies its pixels when copied
+    typedef sf::RenderTexture* Layer;   // Render target for UiLayer (see ui.hpp)
+
+    static bool load_texture(const std::string& path, Texture& out, AlphaMap& alpha) {
+        sf::Image image;
+        if (!image.loadFromFile(path)) return false;
+
+        // Read the alpha channel while the pixels are still on the CPU, and upload only the trimmed part
+        int w = static_cast<int>(image.getSize().x), h = static_cast<int>(image.getSize().y);
+        alpha.assign_rgba(image.getPixelsPtr(), w, h, w * 4);
+        alpha.trim();
+
+        sf::Texture* texture = new sf::Texture();
+        if (!texture->loadFromImage(image, sf::IntRect(alpha.offset_x, alpha.offset_y, alpha.width, alpha.height))) {
+            delete texture;
+            return false;
         }
-        textures.push_back(std::move(texture));
-        sprite.setTexture(textures[0]);
-        sprite.setScale(scale, scale);
+        out = texture;
+        return true;
     }
 
-    Obj(const std::vector<std::string>& paths, int x_pos, int y_pos, float scale_factor, float frame_duration)
-        : x(x_pos), y(y_pos), scale(scale_factor), current_frame(0), frame_time(frame_duration), elapsed_time(0.0f) {
-        for (const auto& path : paths) {
-            sf::Texture texture;
-            if (!texture.loadFromFile(path)) {
-                throw std::runtime_error("Failed to load texture: " + path);
-            }
-            textures.push_back(std::move(texture));
+    static void unload_texture(Texture texture) {
+        for (size_t i = 0; i < main_batch_open; i++) {
+            if (main_batches[i].texture == texture) flush_batches();   // Its quads still point at it
         }
-        sprite.setTexture(textures[0]);
-        sprite.setScale(scale, scale);
+        delete texture;
     }
 
-    void render(float delta_time = 0.0f) {
-        if (textures.empty()) return;
+    static void texture_size(Texture texture, int& width, int& height) {
+        width = static_cast<int>(texture->getSize().x);
+        height = static_cast<int>(texture->getSize().y);
+    }
 
-        if (textures.size() > 1) {
-            elapsed_time += delta_time;
-            if (elapsed_time >= frame_time) {
-                current_frame = (current_frame + 1) % textures.size();
-                elapsed_time = 0.0f;
-            }
+    static void draw_texture(Texture texture, const TexRect* src, const DrawRect& dst, bool opaque) {
+        count_fill(dst.w, dst.h, opaque);
+        float u0 = 0, v0 = 0;
+        float u1 = static_cast<float>(texture->getSize().x), v1 = static_cast<float>(texture->getSize().y);
+        if (src) {
+            u0 = src->x; v0 = src->y;
+            u1 = src->x + src->w; v1 = src->y + src->h;
         }
-        sprite.setTexture(textures[current_frame]);
-        sprite.setPosition(x, y);
-        main_window.draw(sprite);
+        if (dst.flip & FLIP_HORIZONTAL) std::swap(u0, u1);
+        if (dst.flip & FLIP_VERTICAL) std::swap(v0, v1);
+        batch_quad(batch_for(texture, opaque), dst.x, dst.y, dst.w, dst.h, sf::Color::White, u0, v0, u1, v1, dst.angle);
     }
-};
 
-//--------------------------CLASS OBJ_SPRITE SHEET-----------------------------------
+    // Metrics of the ASCII glyphs at size; also puts them all on the font's texture page
+    static void font_metrics(const sf::Font& font, int size, FontMetrics& metrics) {
+        metrics.size = size;
+        metrics.line_height = font.getLineSpacing(size);
+        for (int i = 0; i < 95; i++) {
+            const sf::Glyph& glyph = font.getGlyph(32 + i, size, false);
+            AtlasGlyph& info = metrics.glyphs[i];
+            info.src = TexRect{glyph.textureRect.left, glyph.textureRect.top, glyph.textureRect.width, glyph.textureRect.height};
+            info.off_x = glyph.bounds.left;
+            info.off_y = size + glyph.bounds.top;       // sf::Text puts the first baseline at y = size
+            info.advance = glyph.advance;
+        }
+    }
 
-/**
- * @class Obj_ss
- * @brief Represents a sprite sheet object, supporting static and animated tiles.
- */
-class Obj_ss : public Obj {
-public:
-    int tile_width;         // Tile width
-    int tile_height;        // Tile height
-    int frame_count;        // Number of animation frames
-    int row_offset;         // Starting row offset
-
-    // Original constructor (default row_offset = 0)
-    Obj_ss(const std::string& path, int x_pos, int y_pos, float scale_factor, 
-           int t_width, int t_height, int frames = 1, float frame_duration = 1.0f)
-        : Obj(path, x_pos, y_pos, scale_factor, frame_duration),
-          tile_width(t_width), tile_height(t_height), frame_count(frames), row_offset(0) {}
-
-    // Overloaded constructor with row offset parameter
-    Obj_ss(const std::string& path, int x_pos, int y_pos, float scale_factor, 
-           int t_width, int t_height, int frames, float frame_duration, int start_row)
-        : Obj(path, x_pos, y_pos, scale_factor, frame_duration),
-          tile_width(t_width), tile_height(t_height), frame_count(frames), row_offset(start_row) {}
-
-    void render(float delta_time = 0.0f) {
-        if (textures.empty() || tile_width <= 0 || tile_height <= 0) return;
-
-        if (frame_count > 1) {
-            elapsed_time += delta_time;
-            if (elapsed_time >= frame_time) {
-                current_frame = (current_frame + 1) % frame_count;
-                elapsed_time = 0.0f;
-            }
+    static bool load_font_atlas(const std::string& path, int size, Texture& out, FontMetrics& metrics) {
+        sf::Font font;
+        if (!font.loadFromFile(path)) return false;
+        font_metrics(font, size, metrics);
+
+        // Every glyph is in the font's page now; keep a copy of it and let the font go
+        out = new sf::Texture(font.getTexture(size));
+        return true;
+    }
+
+    // The font's page read back as a CPU coverage atlas (one byte per texel)
+    static bool rasterize_font(const std::string& path, int size, std::vector<uint8_t>& coverage,
+                               int& width, int& height, FontMetrics& metrics) {
+        sf::Font font;
+        if (!font.loadFromFile(path)) return false;
+        font_metrics(font, size, metrics);
+
+        sf::Image page = font.getTexture(size).copyToImage();
+        width = static_cast<int>(page.getSize().x);
+        height = static_cast<int>(page.getSize().y);
+        const uint8_t* pixels = page.getPixelsPtr();
+        coverage.resize(static_cast<size_t>(width) * height);
+        for (size_t i = 0; i < coverage.size(); i++) coverage[i] = pixels[i * 4 + 3];
+        return true;
+    }
+
+    static void draw_glyphs(Texture atlas, const TextLayout& layout, float x, float y, Color color) {
+        sf::VertexArray& vertices = batch_for(atlas);
+        sf::Color tint(color.r, color.g, color.b, color.a);
+        for (const GlyphQuad& quad : layout.quads) {
+            batch_quad(vertices, x + quad.x, y + quad.y, quad.w, quad.h, tint,
+                       quad.src.x, quad.src.y, quad.src.x + quad.src.w, quad.src.y + quad.src.h);
+            count_fill(quad.w, quad.h, false);
+        }
+    }
+
+    // Distance field texture and the shader that cuts its edge
+    struct SdfField {
+        sf::Texture texture;
+        sf::Shader shader;
+    };
+    typedef SdfField* SdfAtlas;
+
+    static SdfAtlas create_sdf_atlas(const uint8_t* field, int width, int height, float) {
+        if (!sf::Shader::isAvailable()) return nullptr;
+        std::vector<uint8_t> rgba(static_cast<size_t>(width) * height * 4, 255);
+        for (size_t i = 0; i < static_cast<size_t>(width) * height; i++) rgba[i * 4 + 3] = field[i];
+        sf::Image image;
+        image.create(width, height, rgba.data());
+
+        static const char* fragment =
+            "uniform sampler2D texture;\n"
+            "void main() {\n"
+            "    float distance = texture2D(texture, gl_TexCoord[0].xy).a;\n"
+            "    float smoothing = fwidth(distance) * 0.5;\n"         // About one screen pixel at any scale
+            "    float alpha = smoothstep(0.5 - smoothing, 0.5 + smoothing, distance);\n"
+            "    gl_FragColor = vec4(gl_Color.rgb, gl_Color.a * alpha);\n"
+            "}\n";
+        SdfField* atlas = new SdfField();
+        if (!atlas->texture.loadFromImage(image) || !atlas->shader.loadFromMemory(fragment, sf::Shader::Fragment)) {
+            delete atlas;
+            return nullptr;
+        }
+        atlas->texture.setSmooth(true);
+        atlas->shader.setUniform("texture", sf::Shader::CurrentTexture);
+        return atlas;
+    }
+
+    static void destroy_sdf_atlas(SdfAtlas atlas) {
+        delete atlas;
+    }
+
+    // Drawn right away with the shader, outside the sprite batches
+    static void draw_sdf_glyphs(SdfAtlas atlas, const TextLayout& layout, float x, float y, float scale, Color color) {
+        flush_batches();
+        static sf::VertexArray vertices(sf::Triangles);
+        vertices.clear();
+        sf::Color tint(color.r, color.g, color.b, color.a);
+        for (const GlyphQuad& quad : layout.quads) {
+            batch_quad(vertices, x + quad.x * scale, y + quad.y * scale, quad.w * scale, quad.h * scale, tint,
+                       quad.src.x, quad.src.y, quad.src.x + quad.src.w, quad.src.y + quad.src.h);
+            count_fill(quad.w * scale, quad.h * scale, false);
+        }
+        sf::RenderStates states(&atlas->texture);
+        states.shader = &atlas->shader;
+        main_surface().draw(vertices, states);
+        main_draw_calls++;
+    }
+
+    static Layer create_layer(int width, int height) {
+        sf::RenderTexture* layer = new sf::RenderTexture();
+        if (!layer->create(width, height)) {
+            delete layer;
+            return nullptr;
         }
+        return layer;
+    }
 
-        int frames_per_row = textures[0].getSize().x / tile_width;
+    static void destroy_layer(Layer layer) {
+        delete layer;
+    }
 
-        int tile_x = (current_frame % frames_per_row) * tile_width;
-        int tile_y = ((current_frame / frames_per_row) + row_offset) * tile_height;
+    // Batches and text go to main_surface(), which is the layer until end_layer
+    static void begin_layer(Layer layer) {
+        flush_batches();
+        main_layer_target = layer;
+        layer->clear(sf::Color::Transparent);
+    }
 
-        sprite.setTextureRect(sf::IntRect(tile_x, tile_y, tile_width, tile_height));
-        sprite.setPosition(x, y);
-        sprite.setScale(scale, scale);
-        main_window.draw(sprite);
+    static void end_layer(Layer layer) {
+        flush_batches();
+        layer->display();
+        main_layer_target = nullptr;
+    }
+
+    static void draw_layer(Layer layer, int x, int y) {
+        flush_batches();
+        sf::Sprite sprite(layer->getTexture());
+        sprite.setPosition(static_cast<float>(x), static_cast<float>(y));
+        count_fill(static_cast<float>(layer->getSize().x), static_cast<float>(layer->getSize().y), false);
+        // The layer's colors are already multiplied by alpha
+        main_surface().draw(sprite, sf::RenderStates(sf::BlendMode(sf::BlendMode::One, sf::BlendMode::OneMinusSrcAlpha)));
+        main_draw_calls++;
     }
 };
+
+//--------------------------CLASS OBJ--------------------------------------------------
+
+typedef BasicObj<SfmlBackend> Obj;
+typedef BasicObj_ss<SfmlBackend> Obj_ss;
+typedef BasicUiLayer<SfmlBackend> UiLayer;
+typedef BasicTextFont<SfmlBackend> TextFont;
+typedef BasicSdfFont<SfmlBackend> SdfFont;
+
+// Issue the draw calls recorded in a command list (call on the render thread)
+void replay_commands(const CommandList& list) {
+    replay_commands_with<SfmlBackend>(list);
+}
+
 //--------------------------MAIN-----------------------------------------------------
 
 // int main() {
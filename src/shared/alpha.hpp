@@ -0,0 +1,207 @@
+#ifndef ALPHA_HPP
+#define ALPHA_HPP
+
+/**
+ * @file alpha.hpp
+ * @brief Alpha analysis done once at load time. The backends copy each texture's alpha channel
+ *  into an AlphaMap while the pixels are still on the CPU, and the core uses it to flag whole
+ *  textures and sheet frames as opaque, binary-alpha or translucent. Opaque draws go out with
+ *  blending off; everything else is blended as before.
+ *
+ *  The map costs one byte per texel and is kept with the texture (TextureHandle::alpha()).
+ *
+ *  Loading also trims the fully transparent border off every image (AlphaMap::trim) and uploads
+ *  only what is left; the map remembers where that sits in the original image so the core can
+ *  draw it in the same place. Sheet frames are trimmed the same way when their clip is built.
+ */
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+
+//--------------------------ALPHA CLASS------------------------------------------------
+
+enum AlphaClass : uint8_t {
+    ALPHA_OPAQUE,           // Every pixel has alpha 255
+    ALPHA_BINARY,           // Only 0 and 255, e.g. pixel art with a cut-out background
+    ALPHA_TRANSLUCENT       // Soft edges or see-through pixels (also used when unknown)
+};
+
+//--------------------------CLASS ALPHAMAP---------------------------------------------
+
+/**
+ * @class AlphaMap
+ * @brief Alpha channel of a texture, one byte per texel, row-major.
+ */
+class AlphaMap {
+public:
+    int width, height;
+    std::vector<uint8_t> alpha;
+    int offset_x, offset_y;             // Where the map (and its texture) starts in the original image
+    int source_width, source_height;    // Original image size before trimming
+
+    AlphaMap() : width(0), height(0), offset_x(0), offset_y(0), source_width(0), source_height(0) {}
+
+    // Copy the alpha bytes out of 8-bit RGBA pixels (pitch is bytes per row)
+    void assign_rgba(const uint8_t* rgba, int w, int h, int pitch) {
+        width = source_width = w;
+        height = source_height = h;
+        offset_x = offset_y = 0;
+        alpha.resize(static_cast<size_t>(w) * h);
+        for (int row = 0; row < h; row++) {
+            const uint8_t* src = rgba + static_cast<size_t>(row) * pitch + 3;
+            uint8_t* dst = &alpha[static_cast<size_t>(row) * w];
+            for (int col = 0; col < w; col++) dst[col] = src[col * 4];
+        }
+    }
+
+    bool empty() const { return alpha.empty(); }
+
+    uint8_t at(int x, int y) const { return alpha[static_cast<size_t>(y) * width + x]; }
+
+    // Class of a region (clipped to the map); without a map everything counts as translucent
+    AlphaClass classify(int x, int y, int w, int h) const {
+        if (alpha.empty()) return ALPHA_TRANSLUCENT;
+        int x0 = x < 0 ? 0 : x, y0 = y < 0 ? 0 : y;
+        int x1 = x + w > width ? width : x + w;
+        int y1 = y + h > height ? height : y + h;
+        if (x0 >= x1 || y0 >= y1) return ALPHA_TRANSLUCENT;
+
+        AlphaClass result = ALPHA_OPAQUE;
+        for (int row = y0; row < y1; row++) {
+            const uint8_t* a = &alpha[static_cast<size_t>(row) * width];
+            for (int col = x0; col < x1; col++) {
+                if (a[col] == 255) continue;
+                if (a[col] != 0) return ALPHA_TRANSLUCENT;
+                result = ALPHA_BINARY;
+            }
+        }
+        return result;
+    }
+
+    AlphaClass classify() const { return classify(0, 0, width, height); }
+
+    /**
+     * @brief Shrink a region (clipped to the map) to the smallest rect holding all its
+     *  non-transparent pixels. Returns false, leaving the rect alone, if there are none.
+     */
+    bool bounds(int& x, int& y, int& w, int& h) const {
+        int x0 = x < 0 ? 0 : x, y0 = y < 0 ? 0 : y;
+        int x1 = x + w > width ? width : x + w;
+        int y1 = y + h > height ? height : y + h;
+        if (x0 >= x1 || y0 >= y1) return false;
+
+        int min_x = x1, min_y = y1, max_x = x0 - 1, max_y = y0 - 1;
+        for (int row = y0; row < y1; row++) {
+            const uint8_t* a = &alpha[static_cast<size_t>(row) * width];
+            int first = x0;
+            while (first < x1 && a[first] == 0) first++;
+            if (first == x1) continue;
+            int last = x1 - 1;
+            while (last > first && a[last] == 0) last--;
+            if (first < min_x) min_x = first;
+            if (last > max_x) max_x = last;
+            if (row < min_y) min_y = row;
+            max_y = row;
+        }
+        if (max_x < min_x) return false;
+
+        x = min_x;
+        y = min_y;
+        w = max_x - min_x + 1;
+        h = max_y - min_y + 1;
+        return true;
+    }
+
+    // Crop the map to its non-transparent pixels; false if there is nothing to cut (or nothing left)
+    bool trim() {
+        int x = 0, y = 0, w = width, h = height;
+        if (alpha.empty() || !bounds(x, y, w, h)) return false;
+        if (w == width && h == height) return false;
+
+        std::vector<uint8_t> cropped(static_cast<size_t>(w) * h);
+        for (int row = 0; row < h; row++) {
+            const uint8_t* src = &alpha[static_cast<size_t>(y + row) * width + x];
+            std::copy(src, src + w, &cropped[static_cast<size_t>(row) * w]);
+        }
+        alpha.swap(cropped);
+        offset_x += x;
+        offset_y += y;
+        width = w;
+        height = h;
+        return true;
+    }
+};
+
+//--------------------------FILL COUNTERS----------------------------------------------
+
+// Screen pixels covered by textured draws, split by whether blending was on
+struct FillStats {
+    double opaque_pixels;       // Drawn with blending off
+    double blended_pixels;      // Drawn with alpha blending
+};
+
+// Counters for the frame in progress
+inline FillStats& fill_stats() {
+    static FillStats stats = {};
+    return stats;
+}
+
+// Counters for the last finished frame
+inline FillStats& last_frame_fill_stats() {
+    static FillStats stats = {};
+    return stats;
+}
+
+inline void count_fill(float w, float h, bool opaque) {
+    double pixels = static_cast<double>(w) * h;
+    if (pixels < 0) pixels = -pixels;
+    if (opaque) fill_stats().opaque_pixels += pixels;
+    else fill_stats().blended_pixels += pixels;
+}
+
+// Close the current frame's counters (called from stop_drawing)
+inline void end_fill_frame() {
+    last_frame_fill_stats() = fill_stats();
+    fill_stats() = FillStats();
+}
+
+//--------------------------MAIN-----------------------------------------------------
+//
+// Parallax background plus an animated hero; prints how much of the fill still needs blending.
+// The sky is fully opaque and goes out unblended; the mountain and pine layers and the hero
+// sheet have cut-out backgrounds, so they stay blended but are trimmed to what they cover.
+//
+// int main() {
+//     init_window(800, 600, "Fill", 60);
+//
+//     Obj sky("img/background/sky_cloud.png", 0, 0, 1.0f);         // Opaque: blending off
+//     Obj mountains("img/background/mountain.png", 0, 190, 1.0f);   // Cut-out: blended
+//     Obj far_pines("img/background/pine1.png", 0, 250, 1.0f);
+//     Obj near_pines("img/background/pine2.png", 0, 202, 1.0f);
+//     Obj_ss hero("img/Attack1.png", 100, 340, 2.0f, 126, 126, 7, 0.1f);
+//
+//     int frame = 0;
+//     while (!window_should_close()) {
+//         start_drawing();
+//         clear_screen(COLOR_WHITE);
+//         sky.draw();
+//         mountains.draw();
+//         far_pines.draw();
+//         near_pines.draw();
+//         hero.render(1.0f / 60.0f);
+//         stop_drawing();
+//
+//         if (++frame % 60 == 0) {
+//             const FillStats& fill = last_frame_fill_stats();
+//             double total = fill.opaque_pixels + fill.blended_pixels;
+//             printf("blended %.0f of %.0f px (%.1f%%)\n", fill.blended_pixels, total,
+//                    total > 0 ? 100.0 * fill.blended_pixels / total : 0.0);
+//         }
+//     }
+//
+//     quit_window();
+//     return 0;
+// }
+
+#endif // ALPHA_HPP
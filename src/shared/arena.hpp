@@ -0,0 +1,246 @@
+#ifndef ARENA_HPP
+#define ARENA_HPP
+
+/**
+ * @file arena.hpp
+ * @brief Per-frame linear arena, typed free-list pools and allocation counters.
+ *  The backend headers own a main_frame_arena and reset it in stop_drawing, so anything taken
+ *  from it lives until the end of the frame. Neither the arena nor the pools are thread safe.
+ *
+ *  Define HEAVY_COUNT_ALLOCATIONS before including (in the one file that includes the backend)
+ *  to also count every global operator new, which is how to check a steady-state frame allocates nothing.
+ */
+#include <vector>
+#include <atomic>
+#include <new>
+#include <cstdlib>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+//--------------------------ALLOCATION COUNTERS----------------------------------------
+
+struct AllocStats {
+    size_t heap_allocs;         // Global operator new calls (needs HEAVY_COUNT_ALLOCATIONS)
+    size_t arena_allocs;        // FrameArena allocations
+    size_t arena_bytes;         // Bytes handed out by FrameArena
+    size_t arena_overflows;     // Arena allocations that didn't fit and went to the heap
+    size_t pool_allocs;         // Pool::create calls
+    size_t pool_grows;          // Pool chunk allocations from the heap
+};
+
+// Counters for the frame in progress
+inline AllocStats& alloc_stats() {
+    static AllocStats stats = {};
+    return stats;
+}
+
+// Counters for the last finished frame
+inline AllocStats& last_frame_alloc_stats() {
+    static AllocStats stats = {};
+    return stats;
+}
+
+inline std::atomic<size_t>& heap_alloc_counter() {
+    static std::atomic<size_t> count(0);
+    return count;
+}
+
+// Close the current frame's counters (called from stop_drawing)
+inline void end_alloc_frame() {
+    AllocStats& current = alloc_stats();
+    current.heap_allocs = heap_alloc_counter().exchange(0);
+    last_frame_alloc_stats() = current;
+    current = AllocStats();
+}
+
+#ifdef HEAVY_COUNT_ALLOCATIONS
+void* operator new(size_t size) {
+    heap_alloc_counter().fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+void* operator new[](size_t size) {
+    heap_alloc_counter().fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, size_t) noexcept { std::free(p); }
+void operator delete[](void* p, size_t) noexcept { std::free(p); }
+#endif
+
+//--------------------------CLASS FRAMEARENA-------------------------------------------
+
+/**
+ * @class FrameArena
+ * @brief Bump allocator for data that only has to live until the end of the frame.
+ *
+ * If a frame needs more than the capacity the extra comes from the heap (counted as an overflow)
+ * and the next reset() grows the block to the high-water mark, so it settles after one frame.
+ */
+class FrameArena {
+public:
+    explicit FrameArena(size_t capacity_bytes = 64 * 1024)
+        : block(static_cast<unsigned char*>(std::malloc(capacity_bytes))),
+          capacity(block ? capacity_bytes : 0), used(0), high_water(0) {}
+
+    ~FrameArena() {
+        release_overflow();
+        std::free(block);
+    }
+
+    FrameArena(const FrameArena&) = delete;
+    FrameArena& operator=(const FrameArena&) = delete;
+
+    void* allocate(size_t size, size_t align = alignof(std::max_align_t)) {
+        AllocStats& stats = alloc_stats();
+        stats.arena_allocs++;
+        stats.arena_bytes += size;
+
+        size_t start = (used + align - 1) & ~(align - 1);
+        if (start + size <= capacity) {
+            used = start + size;
+            if (used > high_water) high_water = used;
+            return block + start;
+        }
+
+        // Doesn't fit: serve it from the heap this frame, remember how much we really needed
+        stats.arena_overflows++;
+        high_water = start + size > high_water ? start + size : high_water;
+        used = start + size;
+        void* p = std::malloc(size + align);
+        if (!p) throw std::bad_alloc();
+        overflow.push_back(p);
+        uintptr_t aligned = (reinterpret_cast<uintptr_t>(p) + align - 1) & ~(static_cast<uintptr_t>(align) - 1);
+        return reinterpret_cast<void*>(aligned);
+    }
+
+    // Uninitialized array of n T's, T must not need a destructor
+    template <class T>
+    T* alloc_array(size_t n) {
+        static_assert(std::is_trivially_destructible<T>::value, "FrameArena never runs destructors");
+        return static_cast<T*>(allocate(sizeof(T) * n, alignof(T)));
+    }
+
+    template <class T, class... Args>
+    T* create(Args&&... args) {
+        static_assert(std::is_trivially_destructible<T>::value, "FrameArena never runs destructors");
+        return new (allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+    }
+
+    // Drop everything allocated this frame
+    void reset() {
+        if (!overflow.empty()) {
+            release_overflow();
+            size_t grown = high_water + high_water / 2;
+            unsigned char* bigger = static_cast<unsigned char*>(std::malloc(grown));
+            if (bigger) {
+                std::free(block);
+                block = bigger;
+                capacity = grown;
+            }
+        }
+        used = 0;
+    }
+
+    size_t bytes_used() const { return used; }
+    size_t bytes_capacity() const { return capacity; }
+
+private:
+    unsigned char* block;
+    size_t capacity;
+    size_t used;
+    size_t high_water;                  // Most bytes any frame has asked for
+    std::vector<void*> overflow;        // Heap blocks handed out this frame after the arena filled
+
+    void release_overflow() {
+        for (void* p : overflow) std::free(p);
+        overflow.clear();
+    }
+};
+
+//--------------------------CLASS POOL-------------------------------------------------
+
+/**
+ * @class Pool
+ * @brief Free-list pool for objects that are spawned and destroyed all the time (explosions,
+ *  bullets, pickups). Slots come in chunks and are never given back to the heap, so once the pool
+ *  has grown to the peak live count, create/destroy don't allocate.
+ */
+template <class T>
+class Pool {
+public:
+    explicit Pool(size_t chunk = 64) : chunk_size(chunk ? chunk : 1), free_list(nullptr), live_count(0) {}
+
+    ~Pool() {
+        // Live objects still get destroyed; slots themselves are in the chunks
+        for (size_t c = 0; c < chunks.size(); c++) {
+            for (size_t i = 0; i < chunk_size; i++) {
+                Slot& slot = chunks[c][i];
+                if (slot.live) reinterpret_cast<T*>(&slot.storage)->~T();
+            }
+            delete[] chunks[c];
+        }
+    }
+
+    Pool(const Pool&) = delete;
+    Pool& operator=(const Pool&) = delete;
+
+    template <class... Args>
+    T* create(Args&&... args) {
+        if (!free_list) grow();
+        Slot* slot = free_list;
+        T* obj = new (&slot->storage) T(std::forward<Args>(args)...);
+        free_list = slot->next;
+        slot->live = true;
+        live_count++;
+        alloc_stats().pool_allocs++;
+        return obj;
+    }
+
+    void destroy(T* obj) {
+        if (!obj) return;
+        obj->~T();
+        Slot* slot = reinterpret_cast<Slot*>(obj);
+        slot->live = false;
+        slot->next = free_list;
+        free_list = slot;
+        live_count--;
+    }
+
+    // Reserve room for n live objects up front
+    void reserve(size_t n) {
+        while (chunks.size() * chunk_size < n) grow();
+    }
+
+    size_t live() const { return live_count; }
+    size_t capacity() const { return chunks.size() * chunk_size; }
+
+private:
+    struct Slot {
+        alignas(T) unsigned char storage[sizeof(T)];   // Must stay first
+        Slot* next;
+        bool live;
+    };
+
+    size_t chunk_size;
+    std::vector<Slot*> chunks;
+    Slot* free_list;
+    size_t live_count;
+
+    void grow() {
+        Slot* chunk = new Slot[chunk_size];
+        chunks.push_back(chunk);
+        for (size_t i = chunk_size; i-- > 0;) {
+            chunk[i].live = false;
+            chunk[i].next = free_list;
+            free_list = &chunk[i];
+        }
+        alloc_stats().pool_grows++;
+    }
+};
+
+#endif // ARENA_HPP
@@ -0,0 +1,254 @@
+#ifndef CAPTURE_HPP
+#define CAPTURE_HPP
+
+/**
+ * @file capture.hpp
+ * @brief Screenshots and footage without stalling the frame on encoding. stop_drawing copies the
+ *  finished frame into a pooled buffer and a background thread writes it out, as a PNG (with the
+ *  backend's encoder) or appended to a raw RGBA video stream.
+ *
+ *  At most max_in_flight frames are waiting to be written; past that, video frames are dropped
+ *  and screenshots wait for the next frame, so the game never waits on the disk.
+ *
+ *  A raw stream plays back with
+ *      ffmpeg -f rawvideo -pixel_format rgba -video_size 800x600 -framerate 60 -i run.rgba run.mp4
+ */
+#include <vector>
+#include <deque>
+#include <string>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdint>
+#include <cstddef>
+
+//--------------------------CAPTURE FRAME----------------------------------------------
+
+struct CaptureFrame {
+    std::vector<uint8_t> pixels;    // RGBA, top row first, width * 4 bytes per row
+    int width, height;
+    std::string png_path;           // Screenshot to write, empty if none
+    bool video;                     // Append to the open video stream
+};
+
+// Writes tightly packed RGBA pixels as a PNG; called on the capture thread
+typedef bool (*PngWriter)(const std::string& path, const uint8_t* rgba, int width, int height);
+
+struct CaptureStats {
+    size_t captured;        // Frames copied out of the framebuffer
+    size_t dropped;         // Frames skipped because too many were still being written
+    size_t written;         // PNGs and video frames written by the capture thread
+    size_t failed;          // PNGs that couldn't be written
+    double grab_ms;         // Total time spent copying frames on the game thread
+};
+
+//--------------------------CLASS FRAMECAPTURE-----------------------------------------
+
+/**
+ * @class FrameCapture
+ * @brief Buffer pool, in-flight limit and writer thread. The backends own one (main_capture),
+ *  expose screenshot / start_video / stop_video, and feed it from stop_drawing:
+ *
+ *  if (main_capture.wants_frame()) {
+ *      CaptureFrame* frame = main_capture.acquire(w, h);   // nullptr: dropped
+ *      if (frame) { ...copy the back buffer into frame->pixels...; main_capture.submit(frame, ms); }
+ *  }
+ */
+class FrameCapture {
+public:
+    explicit FrameCapture(PngWriter png_writer, size_t max_in_flight = 3)
+        : writer(png_writer), limit(max_in_flight ? max_in_flight : 1), video_file(nullptr),
+          video_every(1), video_counter(0), want_video(false), busy(0), stopping(false), stats_() {}
+
+    ~FrameCapture() { finish(); }
+
+    FrameCapture(const FrameCapture&) = delete;
+    FrameCapture& operator=(const FrameCapture&) = delete;
+
+    // Save the next presented frame as a PNG
+    void screenshot(const std::string& path) {
+        pending_png.push_back(path);
+    }
+
+    // Start appending every n-th frame to a raw RGBA stream at path
+    bool start_video(const std::string& path, int every_nth_frame = 1) {
+        stop_video();
+        std::FILE* file = std::fopen(path.c_str(), "wb");
+        if (!file) return false;
+        std::lock_guard<std::mutex> lock(mutex);
+        video_file = file;
+        video_every = every_nth_frame > 0 ? every_nth_frame : 1;
+        video_counter = 0;
+        return true;
+    }
+
+    // Close the stream once the frames already captured are written
+    void stop_video() {
+        std::unique_lock<std::mutex> lock(mutex);
+        if (!video_file) return;
+        idle.wait(lock, [this] { return queue.empty() && busy == 0; });
+        std::fclose(video_file);
+        video_file = nullptr;
+    }
+
+    bool recording() const { return video_file != nullptr; }
+
+    // Whether stop_drawing should copy this frame out
+    bool wants_frame() {
+        bool video_frame = video_file && (video_counter++ % video_every) == 0;
+        want_video = video_frame;
+        return video_frame || !pending_png.empty();
+    }
+
+    /**
+     * @brief Buffer for a w x h frame, or nullptr if max_in_flight frames are still being written.
+     *  The buffer is filled in by the backend and handed back with submit().
+     */
+    CaptureFrame* acquire(int w, int h) {
+        std::lock_guard<std::mutex> lock(mutex);
+        CaptureFrame* frame = nullptr;
+        if (!free_frames.empty()) {
+            frame = free_frames.back();
+            free_frames.pop_back();
+        } else if (frames.size() < limit) {
+            frames.emplace_back(new CaptureFrame());
+            frame = frames.back().get();
+        } else {
+            stats_.dropped++;       // A waiting screenshot stays in pending_png for the next frame
+            return nullptr;
+        }
+
+        frame->width = w;
+        frame->height = h;
+        frame->pixels.resize(static_cast<size_t>(w) * h * 4);
+        frame->video = want_video;
+        frame->png_path.clear();
+        if (!pending_png.empty()) {
+            frame->png_path = pending_png.front();
+            pending_png.pop_front();
+        }
+        return frame;
+    }
+
+    void submit(CaptureFrame* frame, double grab_ms) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (!worker.joinable()) worker = std::thread(&FrameCapture::run, this);
+            stats_.captured++;
+            stats_.grab_ms += grab_ms;
+            queue.push_back(frame);
+        }
+        wake.notify_one();
+    }
+
+    // Wait until everything captured so far is written
+    void flush() {
+        std::unique_lock<std::mutex> lock(mutex);
+        idle.wait(lock, [this] { return queue.empty() && busy == 0; });
+    }
+
+    // Write what is queued, close the video stream and stop the thread (called from quit_window)
+    void finish() {
+        flush();
+        stop_video();
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        wake.notify_one();
+        if (worker.joinable()) worker.join();
+        stopping = false;
+    }
+
+    CaptureStats stats() {
+        std::lock_guard<std::mutex> lock(mutex);
+        return stats_;
+    }
+
+private:
+    PngWriter writer;
+    size_t limit;                                   // Frames allowed in flight
+    std::vector<std::unique_ptr<CaptureFrame>> frames;
+    std::vector<CaptureFrame*> free_frames;         // Pooled buffers, reused once written
+    std::deque<CaptureFrame*> queue;                // Waiting for the writer thread
+    std::deque<std::string> pending_png;            // Screenshots asked for, not yet captured
+    std::FILE* video_file;
+    int video_every;
+    int video_counter;
+    bool want_video;                                // Current frame goes to the video stream
+    int busy;                                       // Frames the writer is working on
+    bool stopping;
+    CaptureStats stats_;
+    std::thread worker;
+    std::mutex mutex;
+    std::condition_variable wake, idle;
+
+    void run() {
+        std::unique_lock<std::mutex> lock(mutex);
+        for (;;) {
+            wake.wait(lock, [this] { return stopping || !queue.empty(); });
+            if (queue.empty()) return;
+            CaptureFrame* frame = queue.front();
+            queue.pop_front();
+            busy++;
+            std::FILE* file = frame->video ? video_file : nullptr;
+            lock.unlock();
+
+            // Encoding and disk writes happen with the lock released
+            size_t written = 0, failed = 0;
+            if (!frame->png_path.empty()) {
+                if (writer && writer(frame->png_path, frame->pixels.data(), frame->width, frame->height)) written++;
+                else failed++;
+            }
+            if (file && std::fwrite(frame->pixels.data(), 1, frame->pixels.size(), file) == frame->pixels.size()) {
+                written++;
+            }
+
+            lock.lock();
+            busy--;
+            stats_.written += written;
+            stats_.failed += failed;
+            free_frames.push_back(frame);
+            if (queue.empty() && busy == 0) idle.notify_all();
+        }
+    }
+};
+
+//--------------------------MAIN-----------------------------------------------------
+//
+// Capture overhead per frame: run once without recording and once with, compare the
+// game-thread numbers (drawing time and copy time) printed every second.
+//
+// int main(int argc, char** argv) {
+//     init_window(800, 600, "Capture", 0);                // No FPS cap, so times are real
+//     bool record = argc > 1;
+//     if (record) start_video("run.rgba");
+//
+//     Obj_ss animated_tile("img/Attack1.png", 300, 200, 2.0f, 126, 126, 7, 0.1f);
+//     int frames = 0;
+//     double frame_ms = 0.0;
+//     while (!window_should_close()) {
+//         start_drawing();
+//         clear_screen(COLOR_WHITE);
+//         animated_tile.render(1.0f / 60.0f);
+//         stop_drawing();
+//         frame_ms += last_frame_ms();
+//
+//         if (++frames == 300) {
+//             CaptureStats stats = capture_stats();
+//             printf("frame %.3f ms, copy %.3f ms/captured frame, captured %zu dropped %zu written %zu\n",
+//                    frame_ms / frames, stats.captured ? stats.grab_ms / stats.captured : 0.0,
+//                    stats.captured, stats.dropped, stats.written);
+//             screenshot("thumb.png");
+//             frames = 0;
+//             frame_ms = 0.0;
+//         }
+//     }
+//
+//     quit_window();                                       // Writes what is still queued
+//     return 0;
+// }
+
+#endif // CAPTURE_HPP
@@ -1,3 +1,9 @@
+// Color packed into one integer (r in the high byte), so comparing colors is one compare
+inline uint32_t pack_color(Color c) {
+    return (static_cast<uint32_t>(c.r) << 24) | (static_cast<uint32_t>(c.g) << 16) |
+           (static_cast<uint32_t>(c.b) << 8) | static_cast<uint32_t>(c.a);
+}
+
 
 // Predefined color constants
 const Color COLOR_WHITE = {255, 255, 255, 255};
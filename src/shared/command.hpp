@@ -0,0 +1,337 @@
+#ifndef COMMAND_HPP
+#define COMMAND_HPP
+
+/**
+ * @file command.hpp
+ * @brief Recorded draw commands, so a simulation thread can build frame N+1 while the render
+ *  thread replays frame N. Include after one of the backend headers (it uses their Color);
+ *  each backend provides replay_commands(const CommandList&) to turn a list into real draw calls.
+ *
+ *  Every command carries a 64-bit sort key (layer, translucency, texture, depth) and the list is
+ *  radix sorted before it is replayed, so draw order is layer order rather than call order.
+ */
+#include <vector>
+#include <mutex>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+
+//--------------------------SORT KEY---------------------------------------------------
+//
+// Opaque:      [layer 8][0][texture 16][depth 32][unused 7]   grouped by texture
+// Translucent: [layer 8][1][depth 32][texture 16][unused 7]   back to front
+//
+// Larger depth draws later (on top). Opaque draws in one layer are grouped by texture, so the opaque
+// key is only used after CommandList::set_group_opaque(true), for scenes where each opaque draw covers
+// everything under it or doesn't overlap the other opaque draws in its layer.
+
+// 16-bit id for grouping draws by texture (0 is "no texture"); two textures sharing an id only costs batching
+inline uint16_t texture_sort_id(const void* texture) {
+    if (!texture) return 0;
+    uint64_t h = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(texture)) * 0x9E3779B97F4A7C15ull;
+    uint16_t id = static_cast<uint16_t>(h >> 48);
+    return id ? id : 1;
+}
+
+inline uint64_t make_sort_key(uint8_t layer, bool translucent, uint16_t texture_id, uint32_t depth) {
+    uint64_t key = static_cast<uint64_t>(layer) << 56;
+    if (translucent) {
+        key |= 1ull << 55;
+        key |= static_cast<uint64_t>(depth) << 23;
+        key |= static_cast<uint64_t>(texture_id) << 7;
+    } else {
+        key |= static_cast<uint64_t>(texture_id) << 39;
+        key |= static_cast<uint64_t>(depth) << 7;
+    }
+    return key;
+}
+
+inline bool sort_key_translucent(uint64_t key) {
+    return (key >> 55) & 1;
+}
+
+//--------------------------DRAW COMMAND-----------------------------------------------
+
+enum DrawKind : uint8_t {
+    DRAW_CLEAR,
+    DRAW_TEXTURE,
+    DRAW_RECT,
+    DRAW_CIRCLE,
+    DRAW_TEXT
+};
+
+struct DrawCommand {
+    uint64_t key;                       // Sort key (make_sort_key), clears are always 0
+    DrawKind kind;
+    Color color;                        // Clear / shape / text color
+    const void* texture;                // Backend texture: SDL_Texture*, Texture2D*, sf::Texture*
+    int src_x, src_y, src_w, src_h;     // Source rect, src_w == 0 means the whole texture
+    int x, y, w, h;                     // Destination rect (w is the radius for circles)
+    float angle;                        // Texture rotation in degrees, clockwise around the center
+    uint8_t flip;                       // Texture flip bits (FLIP_HORIZONTAL / FLIP_VERTICAL)
+    bool opaque;                        // Texture pixels are all opaque, drawn with blending off
+    uint32_t text;                      // Offset of the string in CommandList::text
+};
+
+//--------------------------CLASS COMMANDLIST------------------------------------------
+
+/**
+ * @class CommandList
+ * @brief One frame of draw commands. Mirrors the immediate draw functions; storage is kept
+ *  between frames so recording a steady scene doesn't allocate.
+ *
+ * set_layer / set_depth apply to the commands recorded after them. By default everything is in
+ * layer 0, translucent, with depth following recording order, so sort() keeps call order.
+ * Opaque textures still draw with blending off; set_group_opaque opts them into the opaque key.
+ */
+class CommandList {
+public:
+    std::vector<DrawCommand> commands;
+    std::vector<char> text;             // NUL separated strings for DRAW_TEXT
+
+    CommandList() : layer(0), depth(0), fixed_depth(false), group_opaque(false), sequence(0) {}
+
+    void clear() {
+        commands.clear();
+        text.clear();
+        layer = 0;
+        fixed_depth = false;
+        group_opaque = false;
+        sequence = 0;
+    }
+
+    void set_layer(uint8_t new_layer) { layer = new_layer; }
+
+    // Give the following commands an explicit depth (larger draws on top), e.g. a sprite's y
+    void set_depth(uint32_t new_depth) {
+        depth = new_depth;
+        fixed_depth = true;
+    }
+
+    // Go back to depth following recording order
+    void use_record_order() { fixed_depth = false; }
+
+    // Sort the following opaque textures ahead of the translucent draws in their layer, grouped
+    // by texture. Only for draws that don't overlap each other (tiles, a full-screen background)
+    void set_group_opaque(bool on) { group_opaque = on; }
+
+    /**
+     * @brief Stable LSD radix sort of the commands by key, 8 bits per pass.
+     *  Passes where every key has the same byte are skipped, so a list that only uses a few
+     *  layers and record-order depth costs a handful of passes.
+     */
+    void sort() {
+        size_t n = commands.size();
+        if (n < 2) return;
+        order.resize(n);
+        scratch.resize(n);
+        for (size_t i = 0; i < n; i++) order[i] = SortEntry{commands[i].key, static_cast<uint32_t>(i)};
+
+        for (int shift = 0; shift < 64; shift += 8) {
+            size_t counts[256] = {};
+            for (size_t i = 0; i < n; i++) counts[(order[i].key >> shift) & 0xFF]++;
+            if (counts[(order[0].key >> shift) & 0xFF] == n) continue;
+
+            size_t offset = 0;
+            for (int b = 0; b < 256; b++) {
+                size_t c = counts[b];
+                counts[b] = offset;
+                offset += c;
+            }
+            for (size_t i = 0; i < n; i++) scratch[counts[(order[i].key >> shift) & 0xFF]++] = order[i];
+            order.swap(scratch);
+        }
+
+        sorted.resize(n);
+        for (size_t i = 0; i < n; i++) sorted[i] = commands[order[i].index];
+        commands.swap(sorted);
+    }
+
+    bool empty() const { return commands.empty(); }
+
+    void clear_screen(Color color) {
+        DrawCommand cmd = {};
+        cmd.kind = DRAW_CLEAR;
+        cmd.color = color;
+        next_depth();
+        commands.push_back(cmd);
+    }
+
+    // opaque: the texture has no transparent pixels, so it is drawn without blending
+    void draw_texture(const void* texture, int src_x, int src_y, int src_w, int src_h,
+                      int x, int y, int w, int h, bool opaque = false,
+                      float angle = 0.0f, uint8_t flip = 0) {
+        DrawCommand cmd = {};
+        cmd.key = make_sort_key(layer, !(opaque && group_opaque), texture_sort_id(texture), next_depth());
+        cmd.kind = DRAW_TEXTURE;
+        cmd.texture = texture;
+        cmd.src_x = src_x; cmd.src_y = src_y; cmd.src_w = src_w; cmd.src_h = src_h;
+        cmd.x = x; cmd.y = y; cmd.w = w; cmd.h = h;
+        cmd.angle = angle;
+        cmd.flip = flip;
+        cmd.opaque = opaque;
+        commands.push_back(cmd);
+    }
+
+    void draw_rect(int x, int y, int width, int height, Color color) {
+        DrawCommand cmd = {};
+        cmd.key = make_sort_key(layer, true, 0, next_depth());
+        cmd.kind = DRAW_RECT;
+        cmd.color = color;
+        cmd.x = x; cmd.y = y; cmd.w = width; cmd.h = height;
+        commands.push_back(cmd);
+    }
+
+    void draw_circle(int x, int y, int radius, Color color) {
+        DrawCommand cmd = {};
+        cmd.key = make_sort_key(layer, true, 0, next_depth());
+        cmd.kind = DRAW_CIRCLE;
+        cmd.color = color;
+        cmd.x = x; cmd.y = y; cmd.w = radius;
+        commands.push_back(cmd);
+    }
+
+    void draw_text(const char* str, int x, int y, Color color) {
+        DrawCommand cmd = {};
+        cmd.key = make_sort_key(layer, true, 0, next_depth());
+        cmd.kind = DRAW_TEXT;
+        cmd.color = color;
+        cmd.x = x; cmd.y = y;
+        cmd.text = static_cast<uint32_t>(text.size());
+        text.insert(text.end(), str, str + std::strlen(str) + 1);
+        commands.push_back(cmd);
+    }
+
+    const char* text_at(const DrawCommand& cmd) const { return &text[cmd.text]; }
+
+private:
+    struct SortEntry {
+        uint64_t key;
+        uint32_t index;
+    };
+
+    uint8_t layer;                      // Layer for the next commands
+    uint32_t depth;                     // Depth set by set_depth
+    bool fixed_depth;                   // Use depth instead of recording order
+    bool group_opaque;                  // Give opaque textures the grouped opaque key
+    uint32_t sequence;                  // Recording order
+    std::vector<SortEntry> order, scratch;     // Radix sort buffers, kept between frames
+    std::vector<DrawCommand> sorted;
+
+    uint32_t next_depth() {
+        uint32_t seq = sequence++;
+        return fixed_depth ? depth : seq;
+    }
+};
+
+//--------------------------CLASS FRAMECOMMANDS----------------------------------------
+
+/**
+ * @class FrameCommands
+ * @brief Two command lists swapped at a fence.
+ *
+ * Simulation thread: CommandList& list = frames.record(); ...obj.record(list)...; frames.publish();
+ * Render thread:     const CommandList* list = frames.acquire(); replay_commands(*list); frames.release();
+ *
+ * publish() is the fence: it waits until the render thread has finished the previous frame,
+ * so the simulation runs at most one frame ahead and never writes a list being replayed.
+ */
+class FrameCommands {
+public:
+    FrameCommands() : back(0), ready(false), rendering(false), closed(false) {}
+
+    // List to record the next frame into, emptied but keeping its storage
+    CommandList& record() {
+        lists[back].clear();
+        return lists[back];
+    }
+
+    // Sort the recorded list and hand it to the render thread, waiting for it to finish the last one first
+    void publish() {
+        lists[back].sort();
+        std::unique_lock<std::mutex> lock(mutex);
+        fence.wait(lock, [this] { return closed || (!ready && !rendering); });
+        if (closed) return;
+        back ^= 1;
+        ready = true;
+        fence.notify_all();
+    }
+
+    // Wait for the next published frame; returns nullptr once close() has been called
+    const CommandList* acquire() {
+        std::unique_lock<std::mutex> lock(mutex);
+        fence.wait(lock, [this] { return closed || ready; });
+        if (!ready) return nullptr;
+        ready = false;
+        rendering = true;
+        return &lists[back ^ 1];
+    }
+
+    // Render thread is done with the list returned by acquire()
+    void release() {
+        std::lock_guard<std::mutex> lock(mutex);
+        rendering = false;
+        fence.notify_all();
+    }
+
+    // Wake both sides up for shutdown
+    void close() {
+        std::lock_guard<std::mutex> lock(mutex);
+        closed = true;
+        fence.notify_all();
+    }
+
+private:
+    CommandList lists[2];
+    int back;                   // Index the simulation thread records into
+    bool ready;                 // Front list published and not yet acquired
+    bool rendering;             // Render thread is replaying the front list
+    bool closed;
+    std::mutex mutex;
+    std::condition_variable fence;
+};
+
+//--------------------------MAIN-----------------------------------------------------
+//
+// #include <thread>
+// #include <atomic>
+//
+// int main() {
+//     init_window(800, 600, "Threaded Game", 60);
+//
+//     Obj_ss animated_tile("img/Attack1.png", 500, 100, 2.0f, 126, 126, 7, 0.1f);
+//     Obj background("img/background/sky_cloud.png", 0, 0, 1.0f);
+//     FrameCommands frames;
+//     std::atomic<bool> running(true);
+//
+//     // Game logic and recording, one frame ahead of the screen
+//     std::thread simulation([&] {
+//         while (running) {
+//             CommandList& list = frames.record();
+//             list.clear_screen(COLOR_WHITE);
+//             list.set_layer(1);                  // Characters over the background,
+//             animated_tile.update(1.0f / 60.0f);
+//             animated_tile.record(list);
+//             list.set_layer(0);                  // even though it is recorded after them
+//             background.record(list);
+//             frames.publish();
+//         }
+//     });
+//
+//     // Draw calls stay on the main thread
+//     while (!window_should_close()) {
+//         const CommandList* list = frames.acquire();
+//         start_drawing();
+//         replay_commands(*list);
+//         stop_drawing();
+//         frames.release();
+//     }
+//
+//     running = false;
+//     frames.close();
+//     simulation.join();
+//     quit_window();
+//     return 0;
+// }
+
+#endif // COMMAND_HPP
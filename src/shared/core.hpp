@@ -0,0 +1,643 @@
+#ifndef CORE_HPP
+#define CORE_HPP
+
+/**
+ * @file core.hpp
+ * @brief Obj / Obj_ss written once for every backend. Each backend header describes itself with a
+ *  policy struct of static functions and then does
+ *
+ *      #include "core.hpp"
+ *      struct SdlBackend { ... };
+ *      typedef BasicObj<SdlBackend> Obj;
+ *      typedef BasicObj_ss<SdlBackend> Obj_ss;
+ *
+ *  The policy is a template parameter, so every backend call is resolved at compile time and
+ *  inlined; there are no virtual functions. A backend policy provides:
+ *
+ *      typedef ... Texture;                                            // SDL_Texture*, Texture2D*, sf::Texture*
+ *      static bool load_texture(const std::string& path, Texture& out, AlphaMap& alpha);
+ *      static void unload_texture(Texture texture);
+ *      static void texture_size(Texture texture, int& width, int& height);
+ *      static void draw_texture(Texture texture, const TexRect* src, const DrawRect& dst, bool opaque);
+ *
+ *  load_texture fills alpha from the image, trims it (AlphaMap::trim) and uploads only the
+ *  trimmed part (see alpha.hpp); draw_texture is told when the source pixels are all opaque so
+ *  it can turn blending off.
+ *
+ *  Texture is always a pointer to an object the backend keeps on the heap (nullptr when empty),
+ *  so moving a TextureHandle, and with it an Obj, only copies a pointer.
+ *
+ *  Include it after the backend's Color and clear_screen / draw_rect / draw_circle / draw_text,
+ *  which replay_commands_with uses.
+ */
+#include <string>
+#include <vector>
+#include <stdexcept>
+#include <iostream>
+#include <cmath>
+#include "command.hpp"
+#include "arena.hpp"
+#include "effect.hpp"
+#include "alpha.hpp"
+#include "mask.hpp"
+#include "idle.hpp"
+
+//--------------------------RECTS------------------------------------------------------
+
+// Source rect in texture pixels
+struct TexRect {
+    int x, y, w, h;
+};
+
+enum Flip : uint8_t {
+    FLIP_NONE = 0,
+    FLIP_HORIZONTAL = 1,    // Mirror left-right (a right-facing frame drawn facing left)
+    FLIP_VERTICAL = 2
+};
+
+// Destination rect on screen, rotated clockwise by angle degrees around its center and flipped
+struct DrawRect {
+    float x, y, w, h;
+    float angle;
+    uint8_t flip;           // Flip bits
+};
+
+/**
+ * @brief Screen rect for a trimmed rect that sits at (off_x, off_y) inside a cell_w x cell_h cell
+ *  drawn at (x, y). Flipping mirrors the offset inside the cell and rotation turns around the
+ *  cell's center, so trimmed frames flip and rotate exactly like the untrimmed image would.
+ */
+inline DrawRect place_rect(float x, float y, float scale, int off_x, int off_y, int w, int h,
+                           int cell_w, int cell_h, float angle = 0.0f, uint8_t flip = FLIP_NONE) {
+    if (flip & FLIP_HORIZONTAL) off_x = cell_w - off_x - w;
+    if (flip & FLIP_VERTICAL) off_y = cell_h - off_y - h;
+    DrawRect dst = {x + off_x * scale, y + off_y * scale, w * scale, h * scale, angle, flip};
+
+    if (angle != 0.0f && (off_x * 2 + w != cell_w || off_y * 2 + h != cell_h)) {
+        float cx = x + cell_w * scale / 2, cy = y + cell_h * scale / 2;
+        float tx = dst.x + dst.w / 2 - cx, ty = dst.y + dst.h / 2 - cy;
+        float radians = angle * 3.14159265f / 180.0f;
+        float c = std::cos(radians), s = std::sin(radians);
+        dst.x = cx + tx * c - ty * s - dst.w / 2;
+        dst.y = cy + tx * s + ty * c - dst.h / 2;
+    }
+    return dst;
+}
+
+//--------------------------CLASS TEXTUREHANDLE---------------------------------------
+
+/**
+ * @class TextureHandle
+ * @brief Owns one backend texture and unloads it on destruction. Move-only, so a texture is
+ *  never freed twice and containers of Obj can grow or compact without touching the GPU.
+ *  Also keeps the texture's alpha map and its alpha class, worked out once when it was taken over.
+ */
+template <class Backend>
+class TextureHandle {
+public:
+    typedef typename Backend::Texture Texture;
+
+    TextureHandle() : texture(nullptr), w(0), h(0), cls(ALPHA_TRANSLUCENT) {}
+    explicit TextureHandle(Texture t) : texture(nullptr), w(0), h(0), cls(ALPHA_TRANSLUCENT) { reset(t); }
+    TextureHandle(Texture t, AlphaMap&& map) : texture(nullptr), w(0), h(0), cls(ALPHA_TRANSLUCENT) {
+        reset(t, std::move(map));
+    }
+    ~TextureHandle() { reset(); }
+
+    TextureHandle(const TextureHandle&) = delete;
+    TextureHandle& operator=(const TextureHandle&) = delete;
+
+    TextureHandle(TextureHandle&& other) noexcept
+        : texture(other.texture), w(other.w), h(other.h), map(std::move(other.map)), cls(other.cls) {
+        other.texture = nullptr;
+    }
+
+    TextureHandle& operator=(TextureHandle&& other) noexcept {
+        if (this != &other) {
+            reset();
+            texture = other.texture;
+            w = other.w;
+            h = other.h;
+            map = std::move(other.map);
+            cls = other.cls;
+            other.texture = nullptr;
+        }
+        return *this;
+    }
+
+    Texture get() const { return texture; }
+    operator Texture() const { return texture; }
+
+    // Size queried once when the texture was taken over, not on every draw
+    int width() const { return w; }
+    int height() const { return h; }
+
+    // Image the texture was trimmed from, and where the texture sits in it
+    int source_width() const { return map.empty() ? w : map.source_width; }
+    int source_height() const { return map.empty() ? h : map.source_height; }
+    int offset_x() const { return map.offset_x; }
+    int offset_y() const { return map.offset_y; }
+
+    const AlphaMap& alpha() const { return map; }
+    AlphaClass alpha_class() const { return cls; }
+    bool opaque() const { return cls == ALPHA_OPAQUE; }
+
+    // Unload the current texture (if any) and take ownership of t
+    void reset(Texture t = nullptr) {
+        reset(t, AlphaMap());
+    }
+
+    void reset(Texture t, AlphaMap&& alpha_map) {
+        if (texture) Backend::unload_texture(texture);
+        texture = t;
+        w = h = 0;
+        if (texture) Backend::texture_size(texture, w, h);
+        map = std::move(alpha_map);
+        cls = map.classify();
+    }
+
+    // Give up ownership without unloading
+    Texture release() {
+        Texture t = texture;
+        texture = nullptr;
+        return t;
+    }
+
+private:
+    Texture texture;
+    int w, h;
+    AlphaMap map;           // Empty if the backend couldn't read the pixels
+    AlphaClass cls;
+};
+
+//--------------------------CLASS OBJ--------------------------------------------------
+
+/**
+ * @class BasicObj
+ * @brief Represents a general object that can be rendered with static or animated textures.
+ * @brief you can use to render objects of a single sprite (e.g player.png) where the sprite is a single image and may not need to change (!animatable)
+ * @brief if also the object needs to be animated but the sprite are of different files; create an array of the files path and then pass the array variable to where you would pass the single image path as usual
+ */
+template <class Backend>
+class BasicObj {
+public:
+    typedef typename Backend::Texture Texture;
+    typedef TextureHandle<Backend> Handle;
+
+    int x, y;                      // Position
+    float scale;                   // Scale for rendering
+    std::vector<Handle> textures;  // Textures (single or multiple for animation)
+    int current_frame;             // Current animation frame
+    float frame_time;              // Time per frame (defaults to 1.0f for static objects)
+    float elapsed_time;            // Time accumulator
+    float angle;                   // Rotation in degrees, clockwise around the center
+    uint8_t flip;                  // FLIP_HORIZONTAL / FLIP_VERTICAL bits, e.g. to face left
+    mutable std::vector<CollisionMask> masks;   // One per frame after build_masks(), refreshed by current_mask()
+    int mask_threshold;            // Alpha threshold given to build_masks(), -1 if masks aren't used
+
+    BasicObj(const std::string& path, int x_pos, int y_pos, float scale_factor, float frame_duration = 1.0f)
+        : x(x_pos), y(y_pos), scale(scale_factor), current_frame(0), frame_time(frame_duration), elapsed_time(0.0f),
+          angle(0.0f), flip(FLIP_NONE), mask_threshold(-1) {
+        load(path);
+    }
+
+    BasicObj(const std::vector<std::string>& paths, int x_pos, int y_pos, float scale_factor, float frame_duration)
+        : x(x_pos), y(y_pos), scale(scale_factor), current_frame(0), frame_time(frame_duration), elapsed_time(0.0f),
+          angle(0.0f), flip(FLIP_NONE), mask_threshold(-1) {
+        textures.reserve(paths.size());
+        for (const auto& path : paths) {
+            load(path);
+        }
+    }
+
+    // Textures are owned, so objects move (cheaply) but never copy
+    BasicObj(const BasicObj&) = delete;
+    BasicObj& operator=(const BasicObj&) = delete;
+    BasicObj(BasicObj&&) noexcept = default;
+    BasicObj& operator=(BasicObj&&) noexcept = default;
+
+    // Advance the animation without drawing (safe to run off the render thread)
+    void update(float delta_time) {
+        if (textures.size() > 1) {
+            elapsed_time += delta_time;
+            if (elapsed_time >= frame_time) {
+                current_frame = (current_frame + 1) % textures.size();
+                elapsed_time = 0.0f;
+            }
+        }
+    }
+
+    // Seconds until update() moves to the next frame, negative if not animated (see request_redraw_in)
+    float time_to_next_frame() const {
+        if (textures.size() < 2) return -1.0f;
+        float left = frame_time - elapsed_time;
+        return left > 0.0f ? left : 0.0f;
+    }
+
+    // Draw the current frame without touching animation state
+    void draw() {
+        if (textures.empty()) return;
+        const Handle& texture = textures[current_frame];
+        Backend::draw_texture(texture.get(), nullptr, dst_rect(texture), texture.opaque());
+    }
+
+    // Record the current frame into a command list instead of drawing it
+    void record(CommandList& list) const {
+        if (textures.empty()) return;
+        const Handle& texture = textures[current_frame];
+        DrawRect dst = dst_rect(texture);
+        list.draw_texture(texture.get(), 0, 0, 0, 0, static_cast<int>(dst.x), static_cast<int>(dst.y),
+                          static_cast<int>(dst.w), static_cast<int>(dst.h), texture.opaque(), angle, flip);
+    }
+
+    void render(float delta_time = 0.0f) {
+        update(delta_time);
+        draw();
+    }
+
+    // Where the current frame lands on screen
+    DrawRect current_rect() const {
+        return textures.empty() ? DrawRect{static_cast<float>(x), static_cast<float>(y), 0, 0, 0, 0}
+                                : dst_rect(textures[current_frame]);
+    }
+
+    // Build a collision mask per frame at the current scale and flip
+    void build_masks(uint8_t threshold = 128) {
+        mask_threshold = threshold;
+        make_masks();
+    }
+
+    // Mask of the current frame; made again if the object turned (flip) or was rescaled since
+    const CollisionMask* current_mask() const {
+        if (mask_threshold < 0) return nullptr;
+        if (masks.size() != textures.size()) make_masks();     // Frames were added or removed
+        if (masks.empty()) return nullptr;
+        size_t index = current_frame % masks.size();
+        CollisionMask& mask = masks[index];
+        if (mask.flip != flip || mask.scale != scale) {
+            const Handle& texture = textures[index];
+            mask = CollisionMask(texture.alpha(), 0, 0, texture.width(), texture.height(), scale, flip, mask.threshold);
+        }
+        return &mask;
+    }
+
+protected:
+    void make_masks() const {
+        masks.clear();
+        masks.reserve(textures.size());
+        for (const Handle& texture : textures) {
+            masks.emplace_back(texture.alpha(), 0, 0, texture.width(), texture.height(), scale, flip,
+                               static_cast<uint8_t>(mask_threshold));
+        }
+    }
+
+    void load(const std::string& path) {
+        Texture texture = nullptr;
+        AlphaMap alpha;
+        if (!Backend::load_texture(path, texture, alpha)) {
+            throw std::runtime_error("Failed to load texture: " + path);
+        }
+        textures.emplace_back(texture, std::move(alpha));
+    }
+
+    // Trimmed texture placed where it was in the original image
+    DrawRect dst_rect(const Handle& texture) const {
+        return place_rect(static_cast<float>(x), static_cast<float>(y), scale,
+                          texture.offset_x(), texture.offset_y(), texture.width(), texture.height(),
+                          texture.source_width(), texture.source_height(), angle, flip);
+    }
+};
+
+//--------------------------CLASS OBJ_SPRITE SHEET-----------------------------------
+
+/**
+ * @class BasicObj_ss
+ * @brief Represents a sprite sheet object, supporting static and animated tiles.
+ *
+ * This class handles rendering static or animated tiles from a single sprite sheet.
+ * The source rect of every frame is worked out once per clip (constructor, set_clip,
+ * update_animation_ss) so drawing is a table lookup. Clips may wrap onto following rows,
+ * and sheets with frames of different sizes can pass their own rect table.
+ * Each frame is trimmed to its visible pixels and drawn at its offset inside the original cell,
+ * so transparent padding is never drawn.
+ */
+template <class Backend>
+class BasicObj_ss : public BasicObj<Backend> {
+public:
+    typedef BasicObj<Backend> Base;
+    typedef typename Base::Handle Handle;
+    typedef typename Backend::Texture Texture;
+    using Base::x;
+    using Base::y;
+    using Base::scale;
+    using Base::textures;
+    using Base::current_frame;
+    using Base::frame_time;
+    using Base::elapsed_time;
+    using Base::angle;
+    using Base::flip;
+    using Base::masks;
+    using Base::mask_threshold;
+
+    int tile_width;         // Tile width
+    int tile_height;        // Tile height
+    int frame_count;        // Number of animation frames
+    int row_offset;         // Starting row offset
+    int column_offset;      // Starting column on the first row
+    std::vector<TexRect> frames;    // Trimmed source rect of each frame in the current clip, in texture pixels
+    std::vector<TexRect> frame_offsets;     // Trimmed rect's offset in its cell (x, y) and the cell size (w, h)
+    std::vector<AlphaClass> frame_alpha;    // Alpha class of each frame's trimmed rect
+
+    // Original constructor (default row_offset = 0)
+    BasicObj_ss(const std::string& path, int x_pos, int y_pos, float scale_factor,
+                int t_width, int t_height, int frames = 1, float frame_duration = 1.0f)
+        : Base(path, x_pos, y_pos, scale_factor, frame_duration),
+          tile_width(t_width), tile_height(t_height), frame_count(frames), row_offset(0), column_offset(0) {
+        build_frames();
+    }
+
+    // Overloaded constructor with row offset parameter
+    BasicObj_ss(const std::string& path, int x_pos, int y_pos, float scale_factor,
+                int t_width, int t_height, int frames, float frame_duration, int start_row)
+        : Base(path, x_pos, y_pos, scale_factor, frame_duration),
+          tile_width(t_width), tile_height(t_height), frame_count(frames), row_offset(start_row), column_offset(0) {
+        build_frames();
+    }
+
+    // Sheet with frames of different sizes, given as their rects on the sheet image in play order
+    BasicObj_ss(const std::string& path, int x_pos, int y_pos, float scale_factor,
+                const std::vector<TexRect>& frame_rects, float frame_duration = 1.0f)
+        : Base(path, x_pos, y_pos, scale_factor, frame_duration),
+          tile_width(0), tile_height(0), frame_count(static_cast<int>(frame_rects.size())),
+          row_offset(0), column_offset(0), frames(frame_rects) {
+        if (!frames.empty()) {
+            tile_width = frames[0].w;
+            tile_height = frames[0].h;
+        }
+        prepare_frames();
+    }
+
+    BasicObj_ss(BasicObj_ss&&) noexcept = default;
+    BasicObj_ss& operator=(BasicObj_ss&&) noexcept = default;
+
+    void update(float delta_time) {
+        if (frame_count > 1) {
+            elapsed_time += delta_time;
+            if (elapsed_time >= frame_time) {
+                current_frame = (current_frame + 1) % frame_count;
+                elapsed_time = 0.0f;
+            }
+        }
+    }
+
+    float time_to_next_frame() const {
+        if (frame_count < 2) return -1.0f;
+        float left = frame_time - elapsed_time;
+        return left > 0.0f ? left : 0.0f;
+    }
+
+    // Pick a clip of uniform tiles: frames run left to right from (start_column, start_row)
+    // and wrap onto the following rows
+    void set_clip(int t_width, int t_height, int frames_in_clip, int start_row, int start_column = 0) {
+        tile_width = t_width;
+        tile_height = t_height;
+        frame_count = frames_in_clip;
+        row_offset = start_row;
+        column_offset = start_column;
+        build_frames();
+        current_frame = 0;
+        elapsed_time = 0.0f;
+        if (mask_threshold >= 0) make_masks();      // The old masks were cut from the old clip
+    }
+
+    // Trimmed source rect of the current frame
+    TexRect frame_rect() const {
+        return frames[current_frame % frames.size()];
+    }
+
+    // Where the current frame's trimmed rect sits in its cell, and the cell size
+    TexRect frame_offset() const {
+        return frame_offsets[current_frame % frame_offsets.size()];
+    }
+
+    DrawRect current_rect() const {
+        if (frames.empty()) return DrawRect{static_cast<float>(x), static_cast<float>(y), 0, 0, 0, 0};
+        return dst_rect(frame_rect(), frame_offset());
+    }
+
+    // Build a collision mask per frame of the clip at the current scale and flip; set_clip()
+    // and update_animation_ss() build them again for the new clip
+    void build_masks(uint8_t threshold = 128) {
+        mask_threshold = threshold;
+        make_masks();
+    }
+
+    // Mask of the current frame; made again if the object turned (flip) or was rescaled since
+    const CollisionMask* current_mask() const {
+        if (mask_threshold < 0 || textures.empty()) return nullptr;
+        if (masks.size() != frames.size()) make_masks();       // The frame table changed
+        if (masks.empty()) return nullptr;
+        size_t index = current_frame % masks.size();
+        CollisionMask& mask = masks[index];
+        if (mask.flip != flip || mask.scale != scale) {
+            const TexRect& src = frames[index];
+            mask = CollisionMask(textures[0].alpha(), src.x, src.y, src.w, src.h, scale, flip, mask.threshold);
+        }
+        return &mask;
+    }
+
+    bool frame_opaque() const {
+        return frame_alpha[current_frame % frame_alpha.size()] == ALPHA_OPAQUE;
+    }
+
+    void draw() {
+        if (textures.empty() || frames.empty()) return;
+
+        const TexRect& src = frame_rect();
+        if (src.w <= 0) return;     // Nothing visible in this frame
+        DrawRect dst = dst_rect(src, frame_offset());
+        Backend::draw_texture(textures[0].get(), &src, dst, frame_opaque());
+    }
+
+    void record(CommandList& list) const {
+        if (textures.empty() || frames.empty()) return;
+
+        const TexRect& src = frame_rect();
+        if (src.w <= 0) return;
+        DrawRect dst = dst_rect(src, frame_offset());
+        list.draw_texture(textures[0].get(), src.x, src.y, src.w, src.h,
+                          static_cast<int>(dst.x), static_cast<int>(dst.y),
+                          static_cast<int>(dst.w), static_cast<int>(dst.h), frame_opaque(), angle, flip);
+    }
+
+    void render(float delta_time = 0.0f) {
+        update(delta_time);
+        draw();
+    }
+
+    // Switch to another sheet / clip, e.g. from Idle to Attack1; duration is for the whole clip
+    void update_animation_ss(const std::string& path, float new_scale, int tile_w, int tile_h, int framecount, float duration, int rowOffset) {
+        // Load the new texture
+        Texture new_texture = nullptr;
+        AlphaMap alpha;
+        if (!Backend::load_texture(path, new_texture, alpha)) {
+            std::cerr << "Failed to load texture: " << path << std::endl;
+            return;
+        }
+
+        // Clear existing textures and add the new one
+        textures.clear();
+        textures.emplace_back(new_texture, std::move(alpha));
+
+        // Update class members with new values
+        frame_time = duration / framecount;
+        scale = new_scale;
+
+        // Rebuilds the frame table and resets animation state
+        set_clip(tile_w, tile_h, framecount, rowOffset);
+    }
+
+private:
+    void make_masks() const {
+        masks.clear();
+        if (textures.empty()) return;
+        masks.reserve(frames.size());
+        for (const TexRect& src : frames) {
+            masks.emplace_back(textures[0].alpha(), src.x, src.y, src.w, src.h, scale, flip,
+                               static_cast<uint8_t>(mask_threshold));
+        }
+    }
+
+    DrawRect dst_rect(const TexRect& src, const TexRect& offset) const {
+        return place_rect(static_cast<float>(x), static_cast<float>(y), scale,
+                          offset.x, offset.y, src.w, src.h, offset.w, offset.h, angle, flip);
+    }
+
+    // Fill the frame table from the uniform tile layout
+    void build_frames() {
+        frames.clear();
+        frame_offsets.clear();
+        frame_alpha.clear();
+        if (textures.empty() || tile_width <= 0 || tile_height <= 0 || frame_count <= 0) return;
+
+        int frames_per_row = textures[0].source_width() / tile_width;
+        if (frames_per_row < 1) frames_per_row = 1;
+
+        frames.reserve(frame_count);
+        for (int i = 0; i < frame_count; i++) {
+            int index = column_offset + i;
+            TexRect src = {
+                (index % frames_per_row) * tile_width,
+                (index / frames_per_row + row_offset) * tile_height,
+                tile_width,
+                tile_height
+            };
+            frames.push_back(src);
+        }
+        prepare_frames();
+    }
+
+    // Turn frame rects on the sheet image into trimmed rects on the (trimmed) texture,
+    // remembering each one's offset in its cell, and classify them
+    void prepare_frames() {
+        frame_offsets.clear();
+        frame_alpha.clear();
+        frame_offsets.reserve(frames.size());
+        frame_alpha.reserve(frames.size());
+        for (TexRect& src : frames) {
+            TexRect cell = {0, 0, src.w, src.h};
+            if (textures.empty()) {
+                frame_offsets.push_back(cell);
+                frame_alpha.push_back(ALPHA_TRANSLUCENT);
+                continue;
+            }
+
+            const Handle& sheet = textures[0];
+            const AlphaMap& alpha = sheet.alpha();
+            TexRect trimmed = {src.x - sheet.offset_x(), src.y - sheet.offset_y(), src.w, src.h};
+            // A cell in the blank margin cut off by trimming has no pixels left on the texture
+            bool outside = trimmed.x >= sheet.width() || trimmed.y >= sheet.height() ||
+                           trimmed.x + trimmed.w <= 0 || trimmed.y + trimmed.h <= 0;
+            if (outside || (!alpha.empty() && !alpha.bounds(trimmed.x, trimmed.y, trimmed.w, trimmed.h))) {
+                trimmed = TexRect{0, 0, 0, 0};      // Fully transparent, skipped when drawing
+            }
+            cell.x = trimmed.x + sheet.offset_x() - src.x;
+            cell.y = trimmed.y + sheet.offset_y() - src.y;
+            frame_offsets.push_back(cell);
+            frame_alpha.push_back(trimmed.w > 0 ? alpha.classify(trimmed.x, trimmed.y, trimmed.w, trimmed.h)
+                                                : ALPHA_TRANSLUCENT);
+            src = trimmed;
+        }
+    }
+};
+
+//--------------------------COMMAND REPLAY---------------------------------------------
+
+// Issue the draw calls recorded in a command list (call on the render thread)
+template <class Backend>
+void replay_commands_with(const CommandList& list) {
+    typedef typename Backend::Texture Texture;
+    for (const DrawCommand& cmd : list.commands) {
+        switch (cmd.kind) {
+        case DRAW_CLEAR:
+            clear_screen(cmd.color);
+            break;
+        case DRAW_TEXTURE: {
+            Texture texture = static_cast<Texture>(const_cast<void*>(cmd.texture));
+            TexRect src = {cmd.src_x, cmd.src_y, cmd.src_w, cmd.src_h};
+            DrawRect dst = {static_cast<float>(cmd.x), static_cast<float>(cmd.y),
+                            static_cast<float>(cmd.w), static_cast<float>(cmd.h), cmd.angle, cmd.flip};
+            Backend::draw_texture(texture, cmd.src_w > 0 ? &src : nullptr, dst, cmd.opaque);
+            break;
+        }
+        case DRAW_RECT:
+            draw_rect(cmd.x, cmd.y, cmd.w, cmd.h, cmd.color);
+            break;
+        case DRAW_CIRCLE:
+            draw_circle(cmd.x, cmd.y, cmd.w, cmd.color);
+            break;
+        case DRAW_TEXT:
+            draw_text(list.text_at(cmd), cmd.x, cmd.y, cmd.color);
+            break;
+        }
+    }
+}
+
+//--------------------------COLLISION------------------------------------------------
+
+/**
+ * @brief Pixel-perfect hit test between two Obj / Obj_ss (any mix). Falls back to the drawn
+ *  rects for an object without masks, so build_masks() on both for exact hits.
+ */
+template <class A, class B>
+bool pixel_overlap(const A& a, const B& b) {
+    DrawRect ra = a.current_rect(), rb = b.current_rect();
+    if (ra.x >= rb.x + rb.w || rb.x >= ra.x + ra.w || ra.y >= rb.y + rb.h || rb.y >= ra.y + ra.h) return false;
+
+    const CollisionMask* ma = a.current_mask();
+    const CollisionMask* mb = b.current_mask();
+    if (!ma || !mb) return true;
+    return masks_overlap(*ma, static_cast<int>(ra.x), static_cast<int>(ra.y),
+                         *mb, static_cast<int>(rb.x), static_cast<int>(rb.y));
+}
+
+//--------------------------EFFECTS--------------------------------------------------
+
+// Draw every live effect in the pool, centered, using the frames of one preloaded clip
+template <class Backend>
+void draw_effects(const EffectPool& effects, const BasicObj<Backend>& clip) {
+    if (clip.textures.empty() || effects.size() == 0) return;
+
+    int frames = static_cast<int>(clip.textures.size());
+    for (size_t i = 0; i < effects.size(); i++) {
+        const TextureHandle<Backend>& texture = clip.textures[effects.frame[i] % frames];
+        float s = clip.scale * effects.scale[i];
+        float left = effects.x[i] - texture.source_width() * s / 2;
+        float top = effects.y[i] - texture.source_height() * s / 2;
+        DrawRect dst = {left + texture.offset_x() * s, top + texture.offset_y() * s,
+                        texture.width() * s, texture.height() * s};
+        Backend::draw_texture(texture.get(), nullptr, dst, texture.opaque());
+    }
+}
+
+#endif // CORE_HPP
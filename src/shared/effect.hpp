@@ -0,0 +1,109 @@
+#ifndef EFFECT_HPP
+#define EFFECT_HPP
+
+/**
+ * @file effect.hpp
+ * @brief Fixed-capacity pool of short-lived effects (explosions, bullets, thrown grenades).
+ *  Every effect shares one preloaded clip, an Obj loaded once from its frame paths, and the
+ *  backend's draw_effects(pool, clip) draws them all. Spawning, updating and retiring never allocate.
+ *
+ *  Obj explosion_clip(explosion_frames, 0, 0, 1.5f, 0.05f);   // img/explosion/exp1..5.png
+ *  EffectPool explosions(512);
+ *  explosions.spawn(grenade_x, grenade_y);
+ *  explosions.update(delta_time, explosion_clip.frame_time, explosion_clip.textures.size());
+ *  draw_effects(explosions, explosion_clip);
+ */
+#include <vector>
+#include <cstddef>
+
+//--------------------------CLASS EFFECTPOOL-------------------------------------------
+
+/**
+ * @class EffectPool
+ * @brief Live effects packed at the front of parallel arrays (structure of arrays).
+ *  A finished effect is retired by moving the last live one into its slot.
+ */
+class EffectPool {
+public:
+    std::vector<float> x, y;        // Center position in pixels
+    std::vector<float> vx, vy;      // Velocity in pixels per second (0 for explosions)
+    std::vector<float> scale;       // Multiplies the clip's own scale
+    std::vector<float> elapsed;     // Time into the current frame
+    std::vector<float> life;        // Seconds left, or 0 to play the clip once and retire
+    std::vector<int> frame;         // Current frame of the clip
+
+    explicit EffectPool(size_t capacity)
+        : x(capacity), y(capacity), vx(capacity), vy(capacity), scale(capacity),
+          elapsed(capacity), life(capacity), frame(capacity), count(0) {}
+
+    // Start an effect centered on (px, py); returns false and drops it if the pool is full
+    bool spawn(float px, float py, float velocity_x = 0.0f, float velocity_y = 0.0f,
+               float effect_scale = 1.0f, float lifetime = 0.0f) {
+        if (count == x.size()) return false;
+        size_t i = count++;
+        x[i] = px;
+        y[i] = py;
+        vx[i] = velocity_x;
+        vy[i] = velocity_y;
+        scale[i] = effect_scale;
+        elapsed[i] = 0.0f;
+        life[i] = lifetime;
+        frame[i] = 0;
+        return true;
+    }
+
+    /**
+     * @brief Move and animate every live effect, retiring the ones that are done.
+     *  Effects with a lifetime loop the clip until it runs out, the rest retire after the last frame
+     *  (or after this update if frame_time <= 0, which never reaches it).
+     */
+    void update(float delta_time, float frame_time, int frame_count) {
+        if (frame_count < 1) frame_count = 1;
+        size_t i = 0;
+        while (i < count) {
+            x[i] += vx[i] * delta_time;
+            y[i] += vy[i] * delta_time;
+            elapsed[i] += delta_time;
+            while (frame_time > 0.0f && elapsed[i] >= frame_time) {
+                elapsed[i] -= frame_time;
+                frame[i]++;
+            }
+
+            bool done;
+            if (life[i] > 0.0f) {
+                life[i] -= delta_time;
+                frame[i] %= frame_count;
+                done = life[i] <= 0.0f;
+            } else {
+                done = frame_time <= 0.0f || frame[i] >= frame_count;   // No frame time: the clip can't advance
+            }
+
+            if (done) {
+                retire(i);      // Slot i now holds an effect that hasn't been updated yet
+            } else {
+                i++;
+            }
+        }
+    }
+
+    void clear() { count = 0; }
+    size_t size() const { return count; }
+    size_t capacity() const { return x.size(); }
+
+private:
+    size_t count;                   // Live effects, stored in [0, count)
+
+    void retire(size_t i) {
+        size_t last = --count;
+        x[i] = x[last];
+        y[i] = y[last];
+        vx[i] = vx[last];
+        vy[i] = vy[last];
+        scale[i] = scale[last];
+        elapsed[i] = elapsed[last];
+        life[i] = life[last];
+        frame[i] = frame[last];
+    }
+};
+
+#endif // EFFECT_HPP
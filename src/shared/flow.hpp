@@ -0,0 +1,307 @@
+#ifndef FLOW_HPP
+#define FLOW_HPP
+
+/**
+ * @file flow.hpp
+ * @brief Flow-field pathfinding for crowds chasing one target (the player). Instead of a path
+ *  search per enemy, one Dijkstra pass from the target over a TileGrid gives every open tile
+ *  its distance to the target, and from that the direction of its best neighbour. An enemy then
+ *  steers by reading the direction of the tile it stands on: O(1), whatever the crowd size.
+ *
+ *  The field is only rebuilt when the target enters another tile or the walls change, the
+ *  rebuild can be spread over several frames with a budget, and enemies keep reading the last
+ *  finished field meanwhile. Moves are 8-way, diagonals only where both side tiles are open.
+ *
+ *  A rebuild is a full Dijkstra pass, not a repair of the previous field: when the target moves
+ *  one tile most distances change anyway, and a repair would need a priority queue keyed on
+ *  both old and new costs for little gain over Dial's buckets. A move that comes in while a
+ *  rebuild is running doesn't restart it; that field is finished and published first (it is at
+ *  most a few tiles stale) and the next rebuild starts from the newest target, so a target that
+ *  moves faster than the budget allows still gets a new field every few frames.
+ */
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <cmath>
+#include "tilemap.hpp"
+#include "job.hpp"
+
+//--------------------------DIRECTIONS-------------------------------------------------
+
+const uint32_t FLOW_UNREACHABLE = 0xFFFFFFFFu;
+const uint32_t FLOW_STRAIGHT = 10;          // Step costs, diagonals ~ sqrt(2) as integers
+const uint32_t FLOW_DIAGONAL = 14;
+const int8_t FLOW_NONE = -1;                // At the target, walled in or out of reach
+
+// Direction d in 0..7, clockwise from +x (y points down)
+const int FLOW_DX[8] = {1, 1, 0, -1, -1, -1, 0, 1};
+const int FLOW_DY[8] = {0, 1, 1, 1, 0, -1, -1, -1};
+
+// Unit vector of direction d
+inline void flow_vector(int d, float& dx, float& dy) {
+    const float diagonal = 0.70710678f;
+    float scale = (d & 1) ? diagonal : 1.0f;
+    dx = FLOW_DX[d] * scale;
+    dy = FLOW_DY[d] * scale;
+}
+
+//--------------------------CLASS FLOWFIELD--------------------------------------------
+
+/**
+ * @class FlowField
+ * @brief Distances and directions toward one target tile over a TileGrid.
+ *
+ *  The grid is read during update(), so change walls between updates and call invalidate().
+ *  horizon_tiles > 0 stops the search that far (in straight steps) from the target; tiles
+ *  further away get no direction, which keeps the cost proportional to the area around the
+ *  player rather than the whole level.
+ *
+ *  FlowField flow(grid, 40);
+ *  ...each frame:
+ *  flow.set_target(player_tx, player_ty);
+ *  flow.update(20000);                         // At most 20000 tiles of work this frame
+ *  flow.steer(enemy.x, enemy.y, dx, dy);
+ */
+class FlowField {
+public:
+    explicit FlowField(const TileGrid& tile_grid, int horizon_tiles = 0)
+        : grid(tile_grid), horizon(horizon_tiles > 0 ? static_cast<uint32_t>(horizon_tiles) * FLOW_STRAIGHT : FLOW_UNREACHABLE),
+          target_x(-1), target_y(-1), wanted(false), in_progress(false), cursor(0), queued(0), build_count(0) {
+        size_t tiles = static_cast<size_t>(grid.width) * grid.height;
+        front_cost.assign(tiles, FLOW_UNREACHABLE);
+        back_cost.assign(tiles, FLOW_UNREACHABLE);
+        front_dir.assign(tiles, FLOW_NONE);
+        back_dir.assign(tiles, FLOW_NONE);
+    }
+
+    FlowField(const FlowField&) = delete;
+    FlowField& operator=(const FlowField&) = delete;
+
+    // Move the target; only a different tile asks for a rebuild
+    void set_target(int tx, int ty) {
+        if (tx == target_x && ty == target_y) return;
+        target_x = tx;
+        target_y = ty;
+        wanted = true;
+    }
+
+    // The walls changed: rebuild even if the target didn't move
+    void invalidate() { wanted = true; }
+
+    /**
+     * @brief Advance the rebuild by at most budget tiles (0 for no limit). Returns true when a
+     *  new field was finished and is now the one read by steer() and friends. A rebuild asked
+     *  for while one is running starts once that one is published. With jobs, the direction
+     *  pass at the end is split across threads.
+     */
+    bool update(size_t budget = 0, JobSystem* jobs = nullptr) {
+        if (wanted && !in_progress) {
+            wanted = false;
+            start();
+        }
+        if (!in_progress) return false;
+
+        size_t done = 0;
+        while (queued > 0) {
+            std::vector<uint32_t>& bucket = buckets[cursor % BUCKETS];
+            if (bucket.empty()) {
+                cursor++;
+                continue;
+            }
+            if (budget && done >= budget) return false;
+            uint32_t index = bucket.back();
+            bucket.pop_back();
+            queued--;
+            done++;
+            if (back_cost[index] != cursor) continue;       // A shorter way was found after it was queued
+            expand(index, cursor);
+        }
+
+        finish(jobs);
+        return true;
+    }
+
+    // True while a rebuild is running (the last finished field is still being served)
+    bool building() const { return in_progress || wanted; }
+
+    // Direction at tile (tx, ty), FLOW_NONE if there is none
+    int direction(int tx, int ty) const {
+        if (tx < 0 || ty < 0 || tx >= grid.width || ty >= grid.height) return FLOW_NONE;
+        return front_dir[static_cast<size_t>(ty) * grid.width + tx];
+    }
+
+    // Path cost from tile (tx, ty) to the target in FLOW_STRAIGHT units, FLOW_UNREACHABLE if none
+    uint32_t distance(int tx, int ty) const {
+        if (tx < 0 || ty < 0 || tx >= grid.width || ty >= grid.height) return FLOW_UNREACHABLE;
+        return front_cost[static_cast<size_t>(ty) * grid.width + tx];
+    }
+
+    // Unit direction to walk from pixel (x, y); false (and 0, 0) if there is nowhere to go
+    bool steer(float x, float y, float& dx, float& dy) const {
+        int d = direction(tile_floor(x, grid.tile_size), tile_floor(y, grid.tile_size));
+        if (d == FLOW_NONE) {
+            dx = dy = 0.0f;
+            return false;
+        }
+        flow_vector(d, dx, dy);
+        return true;
+    }
+
+    // steer() for a whole crowd, stored as arrays, split across the job system
+    void steer_all(JobSystem& jobs, const float* xs, const float* ys, float* dxs, float* dys, size_t count) const {
+        jobs.parallel_for(0, count, 4096, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; i++) steer(xs[i], ys[i], dxs[i], dys[i]);
+        });
+    }
+
+    int target_tx() const { return target_x; }
+    int target_ty() const { return target_y; }
+    size_t builds() const { return build_count; }
+
+private:
+    static const uint32_t BUCKETS = FLOW_DIAGONAL + 1;    // Every queued cost is within one step of the cursor
+
+    const TileGrid& grid;
+    uint32_t horizon;                       // Costs above this aren't expanded
+    int target_x, target_y;
+    bool wanted;                            // A rebuild has been asked for
+    bool in_progress;
+
+    // Dial's algorithm: with small integer step costs, a ring of buckets replaces the heap
+    std::vector<uint32_t> buckets[BUCKETS];
+    uint32_t cursor;                        // Cost being expanded
+    size_t queued;
+
+    std::vector<uint32_t> front_cost, back_cost;    // Front is served, back is being built
+    std::vector<int8_t> front_dir, back_dir;
+    size_t build_count;
+
+    bool open(int tx, int ty) const {
+        return tx >= 0 && ty >= 0 && tx < grid.width && ty < grid.height && !grid.is_solid(tx, ty);
+    }
+
+    // Diagonals may not cut the corner of a solid tile
+    bool can_step(int tx, int ty, int d) const {
+        if (!open(tx + FLOW_DX[d], ty + FLOW_DY[d])) return false;
+        return !(d & 1) || (open(tx + FLOW_DX[d], ty) && open(tx, ty + FLOW_DY[d]));
+    }
+
+    void start() {
+        for (auto& bucket : buckets) bucket.clear();
+        std::fill(back_cost.begin(), back_cost.end(), FLOW_UNREACHABLE);
+        queued = 0;
+        cursor = 0;
+        in_progress = true;
+        if (!open(target_x, target_y)) return;              // Finishes at once with an empty field
+        uint32_t index = static_cast<uint32_t>(target_y) * grid.width + target_x;
+        back_cost[index] = 0;
+        buckets[0].push_back(index);
+        queued = 1;
+    }
+
+    void expand(uint32_t index, uint32_t cost) {
+        int tx = static_cast<int>(index % grid.width), ty = static_cast<int>(index / grid.width);
+        for (int d = 0; d < 8; d++) {
+            if (!can_step(tx, ty, d)) continue;
+            uint32_t next_cost = cost + ((d & 1) ? FLOW_DIAGONAL : FLOW_STRAIGHT);
+            if (next_cost > horizon) continue;
+            uint32_t next = static_cast<uint32_t>(ty + FLOW_DY[d]) * grid.width + (tx + FLOW_DX[d]);
+            if (next_cost >= back_cost[next]) continue;
+            back_cost[next] = next_cost;
+            buckets[next_cost % BUCKETS].push_back(next);
+            queued++;
+        }
+    }
+
+    // Point every reached tile at its cheapest neighbour, then publish the new field
+    void finish(JobSystem* jobs) {
+        auto rows = [this](size_t begin, size_t end) {
+            for (size_t ty = begin; ty < end; ty++) {
+                for (int tx = 0; tx < grid.width; tx++) {
+                    size_t index = ty * grid.width + tx;
+                    uint32_t best = back_cost[index];
+                    int8_t best_dir = FLOW_NONE;
+                    if (best != FLOW_UNREACHABLE && best != 0) {
+                        for (int d = 0; d < 8; d++) {
+                            if (!can_step(tx, static_cast<int>(ty), d)) continue;
+                            uint32_t c = back_cost[(ty + FLOW_DY[d]) * grid.width + (tx + FLOW_DX[d])];
+                            if (c < best) {
+                                best = c;
+                                best_dir = static_cast<int8_t>(d);
+                            }
+                        }
+                    }
+                    back_dir[index] = best_dir;
+                }
+            }
+        };
+        if (jobs) jobs->parallel_for(0, static_cast<size_t>(grid.height), 16, rows);
+        else rows(0, static_cast<size_t>(grid.height));
+
+        front_cost.swap(back_cost);
+        front_dir.swap(back_dir);
+        in_progress = false;
+        build_count++;
+    }
+};
+
+//--------------------------MAIN-----------------------------------------------------
+// Benchmark: 1k, 10k and 100k agents chasing a target around a 256 x 256 maze. The target
+// steps to a random open neighbour every other frame, the field gets at most 16000 tiles of
+// rebuild work per frame (a full pass is ~52000) and every agent reads its direction and moves.
+// Build with -O2 -pthread.
+//
+// #include <chrono>
+// #include <cstdio>
+// #include <random>
+//
+// int main() {
+//     const int size = 256, ts = 16, frames = 300;
+//     std::vector<int> ids(size * size, -1);
+//     std::mt19937 rng(7);
+//     for (int i = 0; i < size * size / 5; i++) ids[rng() % (size * size)] = 1;    // 20% walls
+//     TileGrid grid(ids, size, size, ts);
+//     JobSystem jobs;
+//
+//     for (size_t count : {1000u, 10000u, 100000u}) {
+//         std::vector<float> xs(count), ys(count), dxs(count), dys(count);
+//         for (size_t i = 0; i < count; i++) {
+//             do {
+//                 xs[i] = float(rng() % (size * ts));
+//                 ys[i] = float(rng() % (size * ts));
+//             } while (grid.is_solid(tile_floor(xs[i], ts), tile_floor(ys[i], ts)));
+//         }
+//
+//         FlowField flow(grid);
+//         int tx = size / 2, ty = size / 2;
+//         double field_ms = 0.0, steer_ms = 0.0, worst_ms = 0.0;
+//         for (int f = 0; f < frames; f++) {
+//             int d = rng() % 8;
+//             if (f % 2 == 0 && !grid.is_solid(tx + FLOW_DX[d], ty + FLOW_DY[d])) {     // Player wanders
+//                 tx += FLOW_DX[d];
+//                 ty += FLOW_DY[d];
+//             }
+//             auto t0 = std::chrono::steady_clock::now();
+//             flow.set_target(tx, ty);
+//             flow.update(16000, &jobs);
+//             auto t1 = std::chrono::steady_clock::now();
+//             flow.steer_all(jobs, xs.data(), ys.data(), dxs.data(), dys.data(), count);
+//             jobs.parallel_for(0, count, 4096, [&](size_t begin, size_t end) {
+//                 for (size_t i = begin; i < end; i++) {
+//                     xs[i] += dxs[i] * 2.0f;
+//                     ys[i] += dys[i] * 2.0f;
+//                 }
+//             });
+//             auto t2 = std::chrono::steady_clock::now();
+//             double ms = std::chrono::duration<double, std::milli>(t1 - t0).count();
+//             field_ms += ms;
+//             if (ms > worst_ms) worst_ms = ms;
+//             steer_ms += std::chrono::duration<double, std::milli>(t2 - t1).count();
+//         }
+//         std::printf("%6zu agents: field %.3f ms/frame (worst %.3f, %zu builds), steering %.3f ms/frame\n",
+//                     count, field_ms / frames, worst_ms, flow.builds(), steer_ms / frames);
+//     }
+//     return 0;
+// }
+
+#endif // FLOW_HPP
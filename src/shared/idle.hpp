@@ -0,0 +1,111 @@
+#ifndef IDLE_HPP
+#define IDLE_HPP
+
+/**
+ * @file idle.hpp
+ * @brief On-demand rendering for menus and pause screens. With set_idle_mode(true) the backend's
+ *  window_should_close blocks until input arrives or a requested redraw is due, instead of
+ *  spinning, and frame_needed() says whether anything changed since the last presented frame.
+ *
+ *  Input marks the frame dirty by itself; game code calls mark_dirty() when it changes something
+ *  on its own, and request_redraw_in(seconds) for the next animation step or timer.
+ */
+#include <chrono>
+
+//--------------------------IDLE STATE-------------------------------------------------
+
+struct IdleState {
+    bool enabled;
+    bool dirty;             // Something changed since the last presented frame
+    double wake_at;         // Time a redraw was asked for (idle_now() seconds), < 0 for none
+};
+
+inline IdleState& idle_state() {
+    static IdleState state = {false, true, -1.0};
+    return state;
+}
+
+inline double idle_now() {
+    using namespace std::chrono;
+    return duration<double>(steady_clock::now().time_since_epoch()).count();
+}
+
+inline void set_idle_mode(bool enabled) {
+    idle_state().enabled = enabled;
+    idle_state().dirty = true;
+}
+
+// The next frame has to be drawn
+inline void mark_dirty() {
+    idle_state().dirty = true;
+}
+
+// Draw again in (at most) seconds, e.g. when an animation reaches its next frame; negative is ignored
+inline void request_redraw_in(float seconds) {
+    if (seconds < 0.0f) return;
+    IdleState& state = idle_state();
+    double when = idle_now() + seconds;
+    if (state.wake_at < 0.0 || when < state.wake_at) state.wake_at = when;
+}
+
+// Whether to draw this time round the loop (always true when idle mode is off)
+inline bool frame_needed() {
+    return !idle_state().enabled || idle_state().dirty;
+}
+
+/**
+ * @brief How long window_should_close may block: 0 means don't wait, -1 means wait for input only.
+ *  A redraw that has come due marks the frame dirty here.
+ */
+inline int idle_wait_ms() {
+    IdleState& state = idle_state();
+    if (!state.enabled || state.dirty) return 0;
+    if (state.wake_at < 0.0) return -1;
+    double left = state.wake_at - idle_now();
+    if (left <= 0.0) {
+        state.wake_at = -1.0;
+        state.dirty = true;
+        return 0;
+    }
+    return static_cast<int>(left * 1000.0) + 1;
+}
+
+// Called from stop_drawing
+inline void idle_frame_presented() {
+    idle_state().dirty = false;
+}
+
+//--------------------------MAIN-----------------------------------------------------
+//
+// int main() {
+//     init_window(800, 600, "Menu", 60);
+//     set_idle_mode(true);
+//
+//     Obj start_btn("img/start_btn.png", 300, 200, 1.0f);
+//     Obj exit_btn("img/exit_btn.png", 300, 320, 1.0f);
+//     std::vector<std::string> idle_frames = {"img/player/Idle/0.png", "img/player/Idle/1.png"};
+//     Obj mascot(idle_frames, 100, 400, 2.0f, 0.5f);
+//
+//     double last = 0.0;
+//     while (!window_should_close()) {         // Sleeps here until input or the mascot's next frame
+//         if (!frame_needed()) continue;
+//
+//         double now = idle_now();                 // Seconds since boot: too big for a float
+//         float delta_time = last > 0.0 ? static_cast<float>(now - last) : 0.0f;
+//         last = now;
+//
+//         start_drawing();
+//         clear_screen(COLOR_WHITE);
+//         start_btn.draw();
+//         exit_btn.draw();
+//         mascot.render(delta_time);
+//         stop_drawing();
+//
+//         request_redraw_in(mascot.time_to_next_frame());
+//     }
+//
+//     quit_window();
+//     return 0;
+// }
+
+#endif // IDLE_HPP
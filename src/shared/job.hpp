@@ -0,0 +1,321 @@
+#ifndef JOB_HPP
+#define JOB_HPP
+
+/**
+ * @file job.hpp
+ * @brief Small work-stealing thread pool for the update phase of a frame.
+ *  parallel_for splits an entity range into chunks, JobGraph runs jobs once their dependencies finish.
+ *  Only update work belongs here: draw calls (render, draw_rect, ...) must stay on the thread
+ *  that called init_window, SDL and raylib are not safe to draw from other threads.
+ */
+#include <vector>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <thread>
+#include <functional>
+#include <stdexcept>
+#include <type_traits>
+#include <cstddef>
+
+class JobSystem;
+
+//--------------------------JOB TASK---------------------------------------------------
+
+// One unit of queued work: a plain function pointer over [begin, end), no allocation per task
+struct JobTask {
+    void (*fn)(void* ctx, size_t begin, size_t end);
+    void* ctx;
+    size_t begin, end;
+    std::atomic<size_t>* pending;   // Decremented once the task has run
+};
+
+//--------------------------CLASS JOBGRAPH---------------------------------------------
+
+/**
+ * @class JobGraph
+ * @brief Jobs with dependencies. Build it once, then run it every frame with JobSystem::run.
+ *
+ * JobGraph frame;
+ * int anim = frame.add([&]{ ... });
+ * int ai   = frame.add([&]{ ... });
+ * frame.add([&]{ ... collision ... }, {anim, ai});
+ */
+class JobGraph {
+public:
+    // Dependencies must be jobs added earlier, which also keeps the graph free of cycles
+    int add(std::function<void()> fn, std::vector<int> depends_on = {}) {
+        int id = static_cast<int>(nodes.size());
+        for (int dep : depends_on) {
+            if (dep < 0 || dep >= id) throw std::invalid_argument("JobGraph::add: dependency on a job not added yet");
+        }
+        nodes.push_back(Node{std::move(fn), {}, static_cast<int>(depends_on.size()), 0});
+        for (int dep : depends_on) {
+            nodes[dep].dependents.push_back(id);
+        }
+        return id;
+    }
+
+    size_t size() const { return nodes.size(); }
+
+private:
+    friend class JobSystem;
+
+    struct Node {
+        std::function<void()> fn;
+        std::vector<int> dependents;        // Jobs waiting on this one
+        int dependency_count;               // Number of jobs this one waits on
+        std::atomic<int> remaining;         // Dependencies left in the current run
+
+        Node(std::function<void()> f, std::vector<int> d, int count, int left)
+            : fn(std::move(f)), dependents(std::move(d)), dependency_count(count), remaining(left) {}
+        Node(Node&& other)
+            : fn(std::move(other.fn)), dependents(std::move(other.dependents)),
+              dependency_count(other.dependency_count), remaining(other.remaining.load()) {}
+    };
+
+    std::vector<Node> nodes;
+    JobSystem* system = nullptr;            // Set while the graph is running
+    std::atomic<size_t> pending{0};         // Jobs not finished yet
+};
+
+//--------------------------CLASS JOBSYSTEM--------------------------------------------
+
+/**
+ * @class JobSystem
+ * @brief Worker threads, each with its own deque. Owners pop from the back, idle workers steal
+ *  from the front of someone else's deque. The calling thread works too while it waits.
+ */
+class JobSystem {
+public:
+    // thread_count includes the calling thread, so 1 runs everything inline
+    explicit JobSystem(unsigned thread_count = std::thread::hardware_concurrency()) : stop(false), queued(0) {
+        if (thread_count == 0) thread_count = 1;
+        for (unsigned i = 0; i < thread_count; i++) {
+            queues.push_back(std::unique_ptr<Queue>(new Queue()));
+        }
+        for (unsigned i = 1; i < thread_count; i++) {
+            workers.emplace_back([this, i] { worker_loop(i); });
+        }
+    }
+
+    ~JobSystem() {
+        {
+            std::lock_guard<std::mutex> lock(sleep_mutex);
+            stop = true;
+        }
+        wake.notify_all();
+        for (auto& worker : workers) {
+            worker.join();
+        }
+    }
+
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+
+    unsigned size() const { return static_cast<unsigned>(queues.size()); }
+
+    /**
+     * @brief Call fn(chunk_begin, chunk_end) over [begin, end) split into chunks of at most grain items.
+     *  Returns once every chunk has run. Safe to call from inside another job.
+     */
+    template <class F>
+    void parallel_for(size_t begin, size_t end, size_t grain, F&& fn) {
+        if (begin >= end) return;
+        if (grain == 0) grain = 1;
+        if (queues.size() == 1 || end - begin <= grain) {
+            fn(begin, end);
+            return;
+        }
+
+        typedef typename std::remove_reference<F>::type Fn;
+        std::atomic<size_t> pending((end - begin + grain - 1) / grain);
+        for (size_t i = begin; i < end; i += grain) {
+            size_t stop_at = (end - i < grain) ? end : i + grain;
+            push(JobTask{&call_range<Fn>, static_cast<void*>(&fn), i, stop_at, &pending});
+        }
+        wait(pending);
+    }
+
+    // Run every job in the graph, each after all of its dependencies, and wait for the lot
+    void run(JobGraph& graph) {
+        if (graph.nodes.empty()) return;
+        graph.system = this;
+        graph.pending.store(graph.nodes.size());
+        for (auto& node : graph.nodes) {
+            node.remaining.store(node.dependency_count);
+        }
+        for (size_t i = 0; i < graph.nodes.size(); i++) {
+            if (graph.nodes[i].dependency_count == 0) {
+                push(JobTask{&call_node, &graph, i, i + 1, &graph.pending});
+            }
+        }
+        wait(graph.pending);
+        graph.system = nullptr;
+    }
+
+private:
+    struct Queue {
+        std::mutex mutex;
+        std::deque<JobTask> tasks;
+    };
+
+    std::vector<std::unique_ptr<Queue>> queues;     // [0] belongs to outside threads, [i] to worker i
+    std::vector<std::thread> workers;
+    std::mutex sleep_mutex;
+    std::condition_variable wake;
+    bool stop;
+    std::atomic<int> queued;                        // Tasks sitting in any queue
+
+    // Queue index of the current thread for this system, 0 for threads it didn't create
+    size_t thread_index() const {
+        return current_system() == this ? current_index() : 0;
+    }
+
+    static const JobSystem*& current_system() {
+        static thread_local const JobSystem* system = nullptr;
+        return system;
+    }
+
+    static size_t& current_index() {
+        static thread_local size_t index = 0;
+        return index;
+    }
+
+    template <class Fn>
+    static void call_range(void* ctx, size_t begin, size_t end) {
+        (*static_cast<Fn*>(ctx))(begin, end);
+    }
+
+    static void call_node(void* ctx, size_t index, size_t) {
+        JobGraph& graph = *static_cast<JobGraph*>(ctx);
+        JobGraph::Node& node = graph.nodes[index];
+        node.fn();
+        for (int next : node.dependents) {
+            if (graph.nodes[next].remaining.fetch_sub(1) == 1) {
+                graph.system->push(JobTask{&call_node, &graph, static_cast<size_t>(next),
+                                           static_cast<size_t>(next) + 1, &graph.pending});
+            }
+        }
+    }
+
+    void push(const JobTask& task) {
+        Queue& queue = *queues[thread_index()];
+        {
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            queue.tasks.push_back(task);
+        }
+        queued.fetch_add(1);
+        {
+            std::lock_guard<std::mutex> lock(sleep_mutex);
+        }
+        wake.notify_one();
+    }
+
+    // Pop from our own queue first (newest work, still warm in cache), otherwise steal the oldest
+    bool take(size_t self, JobTask& out) {
+        if (queued.load() == 0) return false;
+        {
+            Queue& own = *queues[self];
+            std::lock_guard<std::mutex> lock(own.mutex);
+            if (!own.tasks.empty()) {
+                out = own.tasks.back();
+                own.tasks.pop_back();
+                queued.fetch_sub(1);
+                return true;
+            }
+        }
+        for (size_t n = 1; n < queues.size(); n++) {
+            Queue& victim = *queues[(self + n) % queues.size()];
+            std::lock_guard<std::mutex> lock(victim.mutex);
+            if (!victim.tasks.empty()) {
+                out = victim.tasks.front();
+                victim.tasks.pop_front();
+                queued.fetch_sub(1);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    static void execute(const JobTask& task) {
+        task.fn(task.ctx, task.begin, task.end);
+        task.pending->fetch_sub(1);
+    }
+
+    // Help out until everything counted by pending has finished
+    void wait(std::atomic<size_t>& pending) {
+        size_t self = thread_index();
+        JobTask task;
+        while (pending.load() != 0) {
+            if (take(self, task)) {
+                execute(task);
+            } else {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    void worker_loop(size_t index) {
+        current_system() = this;
+        current_index() = index;
+        JobTask task;
+        for (;;) {
+            if (take(index, task)) {
+                execute(task);
+                continue;
+            }
+            std::unique_lock<std::mutex> lock(sleep_mutex);
+            wake.wait(lock, [this] { return stop || queued.load() > 0; });
+            if (stop) return;
+        }
+    }
+};
+
+//--------------------------MAIN-----------------------------------------------------
+// Benchmark: advance animation timers and integrate positions for 200k entities,
+// with the update phase run on 1, 4, 8 and 16 threads. Build with -O2 -pthread.
+//
+// #include <chrono>
+// #include <cstdio>
+// #include <cmath>
+//
+// struct Entity { float x, y, vx, vy, elapsed_time, frame_time; int current_frame, frame_count; };
+//
+// int main() {
+//     const size_t count = 200000;
+//     const int frames = 200;
+//     std::vector<Entity> entities(count);
+//     for (size_t i = 0; i < count; i++) {
+//         entities[i] = {float(i % 800), float(i % 600), 30.0f, -10.0f, 0.0f, 0.1f, 0, 6};
+//     }
+//
+//     double base_ms = 0.0;
+//     for (unsigned threads : {1u, 4u, 8u, 16u}) {
+//         JobSystem jobs(threads);
+//         auto start = std::chrono::steady_clock::now();
+//         for (int f = 0; f < frames; f++) {
+//             jobs.parallel_for(0, count, 2048, [&](size_t begin, size_t end) {
+//                 for (size_t i = begin; i < end; i++) {
+//                     Entity& e = entities[i];
+//                     e.elapsed_time += 1.0f / 60.0f;
+//                     if (e.elapsed_time >= e.frame_time) {
+//                         e.current_frame = (e.current_frame + 1) % e.frame_count;
+//                         e.elapsed_time = 0.0f;
+//                     }
+//                     e.vy += 9.8f / 60.0f;
+//                     e.x += e.vx / 60.0f + std::sin(e.y) * 0.01f;
+//                     e.y += e.vy / 60.0f + std::cos(e.x) * 0.01f;
+//                 }
+//             });
+//         }
+//         double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / frames;
+//         if (threads == 1) base_ms = ms;
+//         std::printf("%2u threads: %.3f ms/frame  (x%.2f)\n", threads, ms, base_ms / ms);
+//     }
+//     return 0;
+// }
+
+#endif // JOB_HPP
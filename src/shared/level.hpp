@@ -0,0 +1,633 @@
+#ifndef LEVEL_HPP
+#define LEVEL_HPP
+
+/**
+ * @file level.hpp
+ * @brief Binary level files, memory-mapped and streamed by chunk. A level is cut into square
+ *  chunks of tiles; each chunk stores its tile IDs, its collision bits and the entity spawns
+ *  that fall inside it, and a table at the front says where every chunk is. Empty chunks take
+ *  no space.
+ *
+ *  Opening a level maps the file and reads the header, nothing else, so it takes the same time
+ *  for any size. LevelStreamer then keeps only the chunks around the camera decoded; a loader
+ *  thread decodes (and faults in) new chunks while the game runs, and chunks that fall far
+ *  behind are freed and their pages handed back to the OS. Memory stays bounded by the view.
+ *
+ *  Backend independent; write_level builds files from the row-major tile lists the game uses
+ *  today (see TileGrid). Files are little-endian, as written on x86 and ARM.
+ */
+#include <vector>
+#include <deque>
+#include <string>
+#include <unordered_map>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <cstdint>
+#include <cstddef>
+#include <cmath>
+#include "tilemap.hpp"
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+//--------------------------FILE FORMAT------------------------------------------------
+//
+//  LevelHeader
+//  LevelChunkEntry[chunks_x * chunks_y]        row-major, offset 0 for an empty chunk
+//  chunk data, each 8-byte aligned:
+//      int16_t  tiles[chunk_size * chunk_size]  row-major, -1 for empty (past the level edge too)
+//      uint64_t solid[chunk_size * words]       one bit per tile, words = (chunk_size + 63) / 64 per row
+//      LevelSpawn spawns[spawn_count]
+
+const uint32_t LEVEL_MAGIC = 0x4C564C48;   // "HLVL"
+const uint32_t LEVEL_VERSION = 1;
+
+struct LevelHeader {
+    uint32_t magic;
+    uint32_t version;
+    int32_t width, height;          // Level size in tiles
+    int32_t tile_size;              // Tile size in pixels
+    int32_t chunk_size;             // Chunk side in tiles
+    int32_t chunks_x, chunks_y;
+    uint64_t solid_mask;            // Tile IDs the collision bits were built with
+    uint64_t table_offset;          // Where the chunk table starts
+};
+
+struct LevelChunkEntry {
+    uint64_t offset;                // Start of the chunk data, 0 if the chunk is empty
+    uint32_t size;                  // Bytes of chunk data
+    uint32_t spawn_count;
+};
+
+// An entity placed in the level editor: what to create, and where (in pixels)
+struct LevelSpawn {
+    int32_t type;
+    float x, y;
+    int32_t param;                  // Type-specific, e.g. patrol length or pickup value
+};
+
+//--------------------------CLASS MAPPEDFILE-------------------------------------------
+
+/**
+ * @class MappedFile
+ * @brief Read-only memory map of a whole file.
+ */
+class MappedFile {
+public:
+    MappedFile() : base(nullptr), length(0) {
+#ifdef _WIN32
+        file = INVALID_HANDLE_VALUE;
+        mapping = NULL;
+#endif
+    }
+
+    ~MappedFile() { close(); }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool open(const std::string& path) {
+        close();
+#ifdef _WIN32
+        file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+        if (file == INVALID_HANDLE_VALUE) return false;
+        LARGE_INTEGER size;
+        if (!GetFileSizeEx(file, &size) || size.QuadPart == 0) {
+            close();
+            return false;
+        }
+        mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+        if (!mapping) {
+            close();
+            return false;
+        }
+        base = static_cast<const uint8_t*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+        length = static_cast<size_t>(size.QuadPart);
+#else
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) return false;
+        struct stat info;
+        if (fstat(fd, &info) != 0 || info.st_size == 0) {
+            ::close(fd);
+            return false;
+        }
+        void* mapped = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);                            // The mapping keeps the file open
+        if (mapped == MAP_FAILED) return false;
+        base = static_cast<const uint8_t*>(mapped);
+        length = static_cast<size_t>(info.st_size);
+#endif
+        if (!base) {
+            close();
+            return false;
+        }
+        return true;
+    }
+
+    void close() {
+#ifdef _WIN32
+        if (base) UnmapViewOfFile(base);
+        if (mapping) CloseHandle(mapping);
+        if (file != INVALID_HANDLE_VALUE) CloseHandle(file);
+        mapping = NULL;
+        file = INVALID_HANDLE_VALUE;
+#else
+        if (base) munmap(const_cast<uint8_t*>(base), length);
+#endif
+        base = nullptr;
+        length = 0;
+    }
+
+    const uint8_t* data() const { return base; }
+    size_t size() const { return length; }
+
+    // Hints for a byte range: about to be read / not needed for a while (pages can be dropped)
+    void will_need(size_t offset, size_t bytes) const { advise(offset, bytes, true); }
+    void dont_need(size_t offset, size_t bytes) const { advise(offset, bytes, false); }
+
+private:
+    const uint8_t* base;
+    size_t length;
+#ifdef _WIN32
+    HANDLE file;
+    HANDLE mapping;
+#endif
+
+    void advise(size_t offset, size_t bytes, bool need) const {
+#ifdef _WIN32
+        (void)offset; (void)bytes; (void)need;  // Windows pages the view in and out by itself
+#else
+        if (!base || offset >= length) return;
+        if (bytes > length - offset) bytes = length - offset;
+        size_t page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+        size_t start = offset / page * page;
+        // Only whole pages are dropped, a neighbour chunk may share the edge pages
+        size_t end = need ? offset + bytes : (offset + bytes) / page * page;
+        if (!need) start = (offset + page - 1) / page * page;
+        if (end <= start) return;
+        madvise(const_cast<uint8_t*>(base) + start, end - start, need ? MADV_WILLNEED : MADV_DONTNEED);
+#endif
+    }
+};
+
+//--------------------------CLASS LEVELFILE--------------------------------------------
+
+/**
+ * @class LevelFile
+ * @brief An open level: the mapped file, its header and chunk table. Reading is thread-safe.
+ */
+class LevelFile {
+public:
+    LevelFile() : head(), table(nullptr) {}
+
+    // Map the file and check the header; no chunk is touched
+    bool open(const std::string& path) {
+        table = nullptr;
+        if (!file.open(path)) return false;
+        if (file.size() < sizeof(LevelHeader)) return fail();
+        std::memcpy(&head, file.data(), sizeof(LevelHeader));
+        if (head.magic != LEVEL_MAGIC || head.version != LEVEL_VERSION) return fail();
+        if (head.chunk_size <= 0 || head.chunks_x <= 0 || head.chunks_y <= 0 || head.tile_size <= 0) return fail();
+        size_t table_bytes = static_cast<size_t>(head.chunks_x) * head.chunks_y * sizeof(LevelChunkEntry);
+        if (head.table_offset > file.size() || table_bytes > file.size() - head.table_offset) return fail();
+        table = file.data() + head.table_offset;
+        return true;
+    }
+
+    bool is_open() const { return table != nullptr; }
+    const LevelHeader& header() const { return head; }
+    int chunks_x() const { return head.chunks_x; }
+    int chunks_y() const { return head.chunks_y; }
+    int chunk_pixels() const { return head.chunk_size * head.tile_size; }
+
+    // Table entry of chunk (cx, cy); an empty entry outside the level or if the entry is damaged
+    LevelChunkEntry entry(int cx, int cy) const {
+        LevelChunkEntry e = {0, 0, 0};
+        if (!table || cx < 0 || cy < 0 || cx >= head.chunks_x || cy >= head.chunks_y) return e;
+        std::memcpy(&e, table + (static_cast<size_t>(cy) * head.chunks_x + cx) * sizeof(LevelChunkEntry), sizeof(e));
+        if (e.offset == 0 || e.offset > file.size() || e.size > file.size() - e.offset ||
+            e.size < chunk_bytes(e.spawn_count)) {
+            e.offset = 0;
+            e.size = 0;
+            e.spawn_count = 0;
+        }
+        return e;
+    }
+
+    // Bytes of a chunk with n spawns
+    size_t chunk_bytes(uint32_t spawns) const {
+        size_t cs = static_cast<size_t>(head.chunk_size);
+        return cs * cs * sizeof(int16_t) + cs * ((cs + 63) / 64) * sizeof(uint64_t) + spawns * sizeof(LevelSpawn);
+    }
+
+    const MappedFile& mapped() const { return file; }
+
+private:
+    MappedFile file;
+    LevelHeader head;
+    const uint8_t* table;
+
+    bool fail() {
+        file.close();
+        table = nullptr;
+        return false;
+    }
+};
+
+//--------------------------LEVEL CHUNK------------------------------------------------
+
+// A decoded chunk, owned by LevelStreamer
+struct LevelChunk {
+    int cx, cy;
+    std::vector<int16_t> tiles;         // chunk_size * chunk_size, -1 for empty
+    std::vector<uint64_t> solid;        // chunk_size rows of words_per_row words
+    std::vector<LevelSpawn> spawns;
+    int words_per_row;
+
+    int tile(int x, int y, int chunk_size) const { return tiles[static_cast<size_t>(y) * chunk_size + x]; }
+    bool is_solid(int x, int y) const {
+        return (solid[static_cast<size_t>(y) * words_per_row + (x >> 6)] >> (x & 63)) & 1ull;
+    }
+};
+
+inline void decode_chunk(const LevelFile& level, int cx, int cy, LevelChunk& out) {
+    const LevelHeader& head = level.header();
+    int cs = head.chunk_size;
+    out.cx = cx;
+    out.cy = cy;
+    out.words_per_row = (cs + 63) / 64;
+    out.tiles.assign(static_cast<size_t>(cs) * cs, -1);
+    out.solid.assign(static_cast<size_t>(cs) * out.words_per_row, 0);
+    out.spawns.clear();
+
+    LevelChunkEntry entry = level.entry(cx, cy);
+    if (entry.offset == 0) return;
+    const uint8_t* p = level.mapped().data() + entry.offset;
+    std::memcpy(out.tiles.data(), p, out.tiles.size() * sizeof(int16_t));
+    p += out.tiles.size() * sizeof(int16_t);
+    std::memcpy(out.solid.data(), p, out.solid.size() * sizeof(uint64_t));
+    p += out.solid.size() * sizeof(uint64_t);
+    out.spawns.resize(entry.spawn_count);
+    if (entry.spawn_count) std::memcpy(out.spawns.data(), p, entry.spawn_count * sizeof(LevelSpawn));
+}
+
+//--------------------------CLASS LEVELSTREAMER----------------------------------------
+
+/**
+ * @class LevelStreamer
+ * @brief Keeps the chunks around the camera decoded. update() runs on the game thread once a
+ *  frame: it asks the loader thread for chunks that came into range, takes in the ones it has
+ *  finished, and frees the ones that are now far away. Lookups (tile_at, is_solid, chunk) are
+ *  game-thread only and never wait; a chunk that isn't in yet reads as empty.
+ *
+ *  Chunks within margin chunks of the view are loaded; they are only freed once they are more
+ *  than margin + 1 away, so walking back and forth over a chunk edge doesn't reload anything.
+ */
+class LevelStreamer {
+public:
+    explicit LevelStreamer(const LevelFile& level_file, int margin_chunks = 1)
+        : level(level_file), margin(margin_chunks < 0 ? 0 : margin_chunks), stopping(false),
+          load_count(0), free_count(0) {
+        worker = std::thread(&LevelStreamer::run, this);
+    }
+
+    ~LevelStreamer() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        wake.notify_one();
+        worker.join();
+        for (auto& chunk : resident) delete chunk.second;
+        for (LevelChunk* chunk : ready) delete chunk;
+    }
+
+    LevelStreamer(const LevelStreamer&) = delete;
+    LevelStreamer& operator=(const LevelStreamer&) = delete;
+
+    // The view rect in pixels (camera position and screen size)
+    void update(float view_x, float view_y, float view_w, float view_h) {
+        int span = level.chunk_pixels();
+        int cx0 = static_cast<int>(std::floor(view_x / span)) - margin;
+        int cy0 = static_cast<int>(std::floor(view_y / span)) - margin;
+        int cx1 = static_cast<int>(std::floor((view_x + view_w) / span)) + margin;
+        int cy1 = static_cast<int>(std::floor((view_y + view_h) / span)) + margin;
+        clamp_x(cx0);
+        clamp_x(cx1);
+        clamp_y(cy0);
+        clamp_y(cy1);
+
+        std::vector<LevelChunk*> arrived;
+        bool has_work;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            arrived.swap(ready);
+            for (int cy = cy0; cy <= cy1; cy++) {
+                for (int cx = cx0; cx <= cx1; cx++) {
+                    uint64_t key = chunk_key(cx, cy);
+                    if (resident.count(key) || requested.count(key)) continue;
+                    requested[key] = true;
+                    queue.push_back(key);
+                }
+            }
+            // Drop queued loads that went out of range before the loader got to them
+            for (size_t i = 0; i < queue.size();) {
+                int cx = key_x(queue[i]), cy = key_y(queue[i]);
+                if (cx < cx0 - 1 || cx > cx1 + 1 || cy < cy0 - 1 || cy > cy1 + 1) {
+                    requested.erase(queue[i]);
+                    queue.erase(queue.begin() + i);
+                } else {
+                    i++;
+                }
+            }
+            // Nearest to the view center first, so the chunk the camera is entering isn't
+            // stuck behind ones at the far edge
+            float center_x = (view_x + view_w / 2) / span - 0.5f, center_y = (view_y + view_h / 2) / span - 0.5f;
+            std::sort(queue.begin(), queue.end(), [&](uint64_t a, uint64_t b) {
+                float ax = key_x(a) - center_x, ay = key_y(a) - center_y;
+                float bx = key_x(b) - center_x, by = key_y(b) - center_y;
+                return ax * ax + ay * ay < bx * bx + by * by;
+            });
+            has_work = !queue.empty();
+        }
+        if (has_work) wake.notify_one();
+
+        for (LevelChunk* chunk : arrived) {
+            uint64_t key = chunk_key(chunk->cx, chunk->cy);
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                requested.erase(key);
+            }
+            if (resident.count(key)) {
+                delete chunk;
+                continue;
+            }
+            resident[key] = chunk;
+            load_count++;
+        }
+
+        // Free what is now well outside the view
+        for (auto it = resident.begin(); it != resident.end();) {
+            const LevelChunk* chunk = it->second;
+            if (chunk->cx < cx0 - 1 || chunk->cx > cx1 + 1 || chunk->cy < cy0 - 1 || chunk->cy > cy1 + 1) {
+                LevelChunkEntry entry = level.entry(chunk->cx, chunk->cy);
+                if (entry.offset) level.mapped().dont_need(static_cast<size_t>(entry.offset), entry.size);
+                delete chunk;
+                it = resident.erase(it);
+                free_count++;
+            } else {
+                ++it;
+            }
+        }
+    }
+
+    // Decoded chunk (cx, cy), nullptr if it isn't resident
+    const LevelChunk* chunk(int cx, int cy) const {
+        auto found = resident.find(chunk_key(cx, cy));
+        return found == resident.end() ? nullptr : found->second;
+    }
+
+    // Tile ID at tile (tx, ty), -1 if empty or not loaded yet
+    int tile_at(int tx, int ty) const {
+        const LevelChunk* c = chunk_of(tx, ty);
+        if (!c) return -1;
+        int cs = level.header().chunk_size;
+        return c->tile(tx - c->cx * cs, ty - c->cy * cs, cs);
+    }
+
+    bool is_solid(int tx, int ty) const {
+        const LevelChunk* c = chunk_of(tx, ty);
+        if (!c) return false;
+        int cs = level.header().chunk_size;
+        return c->is_solid(tx - c->cx * cs, ty - c->cy * cs);
+    }
+
+    /**
+     * @brief Copy the collision bits of a window of tiles starting at (tx0, ty0) into grid
+     *  (grid.width x grid.height tiles), e.g. the area around the player, for sweep_body.
+     *  Tiles that aren't loaded count as empty.
+     */
+    void copy_solid(TileGrid& grid, int tx0, int ty0) const {
+        for (int y = 0; y < grid.height; y++) {
+            for (int x = 0; x < grid.width; x++) grid.set_solid(x, y, is_solid(tx0 + x, ty0 + y));
+        }
+    }
+
+    // Resident chunks, to walk the spawns or draw the tiles in view
+    template <class F>
+    void for_each_chunk(F&& fn) const {
+        for (const auto& chunk : resident) fn(*chunk.second);
+    }
+
+    size_t resident_count() const { return resident.size(); }
+    size_t loads() const { return load_count; }
+    size_t frees() const { return free_count; }
+
+    // Block until every requested chunk is loaded (loading screens, tests)
+    void wait_idle() {
+        std::unique_lock<std::mutex> lock(mutex);
+        idle.wait(lock, [this] { return queue.empty() && requested.size() == ready.size(); });
+    }
+
+private:
+    const LevelFile& level;
+    int margin;
+    std::unordered_map<uint64_t, LevelChunk*> resident;    // Game thread only
+
+    // Shared with the loader thread
+    std::mutex mutex;
+    std::condition_variable wake, idle;
+    std::deque<uint64_t> queue;                             // Chunks to load, nearest first
+    std::unordered_map<uint64_t, bool> requested;           // Queued or being loaded
+    std::vector<LevelChunk*> ready;                         // Loaded, not yet taken by update()
+    bool stopping;
+    std::thread worker;
+
+    size_t load_count, free_count;
+
+    static uint64_t chunk_key(int cx, int cy) {
+        return (static_cast<uint64_t>(static_cast<uint32_t>(cy)) << 32) | static_cast<uint32_t>(cx);
+    }
+    static int key_x(uint64_t key) { return static_cast<int32_t>(key & 0xFFFFFFFFull); }
+    static int key_y(uint64_t key) { return static_cast<int32_t>(key >> 32); }
+
+    void clamp_x(int& cx) const { cx = cx < 0 ? 0 : (cx >= level.chunks_x() ? level.chunks_x() - 1 : cx); }
+    void clamp_y(int& cy) const { cy = cy < 0 ? 0 : (cy >= level.chunks_y() ? level.chunks_y() - 1 : cy); }
+
+    const LevelChunk* chunk_of(int tx, int ty) const {
+        if (tx < 0 || ty < 0) return nullptr;
+        int cs = level.header().chunk_size;
+        return chunk(tx / cs, ty / cs);
+    }
+
+    void run() {
+        std::unique_lock<std::mutex> lock(mutex);
+        for (;;) {
+            wake.wait(lock, [this] { return stopping || !queue.empty(); });
+            if (stopping) return;
+            uint64_t key = queue.front();
+            queue.pop_front();
+            lock.unlock();
+
+            // Page faults on the mapped file happen here, not on the game thread
+            LevelChunk* chunk = new LevelChunk();
+            LevelChunkEntry entry = level.entry(key_x(key), key_y(key));
+            if (entry.offset) level.mapped().will_need(static_cast<size_t>(entry.offset), entry.size);
+            decode_chunk(level, key_x(key), key_y(key), *chunk);
+
+            lock.lock();
+            ready.push_back(chunk);
+            if (queue.empty()) idle.notify_all();
+        }
+    }
+};
+
+//--------------------------WRITER-----------------------------------------------------
+
+/**
+ * @brief Write a level file from a row-major tile ID list (-1 for empty) and its spawns.
+ *  Collision bits are built from solid_mask the way TileGrid does. Returns false on I/O errors.
+ */
+inline bool write_level(const std::string& path, const std::vector<int>& tile_ids, int width, int height,
+                        int tile_size, const std::vector<LevelSpawn>& spawns,
+                        uint64_t solid_mask = TILE_SOLID_DEFAULT, int chunk_size = 32) {
+    if (width <= 0 || height <= 0 || tile_size <= 0 || chunk_size <= 0) return false;
+    LevelHeader head = {};
+    head.magic = LEVEL_MAGIC;
+    head.version = LEVEL_VERSION;
+    head.width = width;
+    head.height = height;
+    head.tile_size = tile_size;
+    head.chunk_size = chunk_size;
+    head.chunks_x = (width + chunk_size - 1) / chunk_size;
+    head.chunks_y = (height + chunk_size - 1) / chunk_size;
+    head.solid_mask = solid_mask;
+    head.table_offset = sizeof(LevelHeader);
+
+    size_t chunk_count = static_cast<size_t>(head.chunks_x) * head.chunks_y;
+    std::vector<std::vector<LevelSpawn>> chunk_spawns(chunk_count);
+    int span = chunk_size * tile_size;
+    for (const LevelSpawn& spawn : spawns) {
+        int cx = static_cast<int>(std::floor(spawn.x / span)), cy = static_cast<int>(std::floor(spawn.y / span));
+        if (cx < 0 || cy < 0 || cx >= head.chunks_x || cy >= head.chunks_y) continue;
+        chunk_spawns[static_cast<size_t>(cy) * head.chunks_x + cx].push_back(spawn);
+    }
+
+    std::FILE* file = std::fopen(path.c_str(), "wb");
+    if (!file) return false;
+    std::vector<LevelChunkEntry> table(chunk_count, LevelChunkEntry{0, 0, 0});
+    bool ok = std::fwrite(&head, sizeof(head), 1, file) == 1 &&
+              std::fwrite(table.data(), sizeof(LevelChunkEntry), chunk_count, file) == chunk_count;
+    uint64_t offset = sizeof(LevelHeader) + chunk_count * sizeof(LevelChunkEntry);
+
+    int words = (chunk_size + 63) / 64;
+    std::vector<int16_t> tiles(static_cast<size_t>(chunk_size) * chunk_size);
+    std::vector<uint64_t> solid(static_cast<size_t>(chunk_size) * words);
+    const char zeros[8] = {};
+    for (int cy = 0; ok && cy < head.chunks_y; cy++) {
+        for (int cx = 0; ok && cx < head.chunks_x; cx++) {
+            size_t index = static_cast<size_t>(cy) * head.chunks_x + cx;
+            bool empty = chunk_spawns[index].empty();
+            std::fill(tiles.begin(), tiles.end(), static_cast<int16_t>(-1));
+            std::fill(solid.begin(), solid.end(), 0);
+            for (int y = 0; y < chunk_size; y++) {
+                int ty = cy * chunk_size + y;
+                if (ty >= height) break;
+                for (int x = 0; x < chunk_size; x++) {
+                    int tx = cx * chunk_size + x;
+                    if (tx >= width) break;
+                    size_t i = static_cast<size_t>(ty) * width + tx;
+                    int id = i < tile_ids.size() ? tile_ids[i] : -1;
+                    if (id < 0) continue;
+                    empty = false;
+                    tiles[static_cast<size_t>(y) * chunk_size + x] = static_cast<int16_t>(id);
+                    if (tile_is_solid(id, solid_mask)) solid[static_cast<size_t>(y) * words + (x >> 6)] |= 1ull << (x & 63);
+                }
+            }
+            if (empty) continue;                // Stays offset 0, no data
+
+            LevelChunkEntry& entry = table[index];
+            entry.offset = offset;
+            entry.spawn_count = static_cast<uint32_t>(chunk_spawns[index].size());
+            entry.size = static_cast<uint32_t>(tiles.size() * sizeof(int16_t) + solid.size() * sizeof(uint64_t) +
+                                               entry.spawn_count * sizeof(LevelSpawn));
+            ok = std::fwrite(tiles.data(), sizeof(int16_t), tiles.size(), file) == tiles.size() &&
+                 std::fwrite(solid.data(), sizeof(uint64_t), solid.size(), file) == solid.size() &&
+                 (entry.spawn_count == 0 ||
+                  std::fwrite(chunk_spawns[index].data(), sizeof(LevelSpawn), entry.spawn_count, file) == entry.spawn_count);
+            size_t pad = (8 - entry.size % 8) % 8;
+            if (ok && pad) ok = std::fwrite(zeros, 1, pad, file) == pad;
+            offset += entry.size + pad;
+        }
+    }
+
+    // Now that the offsets are known, fill in the table
+    if (ok) ok = std::fseek(file, static_cast<long>(sizeof(LevelHeader)), SEEK_SET) == 0 &&
+                 std::fwrite(table.data(), sizeof(LevelChunkEntry), chunk_count, file) == chunk_count;
+    if (std::fclose(file) != 0) ok = false;
+    return ok;
+}
+
+//--------------------------MAIN-----------------------------------------------------
+//
+// Writes a 4096 x 512 tile level once, then scrolls across it; only the chunks near the
+// camera are ever decoded.
+//
+// int main() {
+//     const int level_w = 4096, level_h = 512, ts = 32;
+//     if (!std::ifstream("big.lvl")) {
+//         std::vector<int> ids(static_cast<size_t>(level_w) * level_h, -1);
+//         std::vector<LevelSpawn> spawns;
+//         for (int x = 0; x < level_w; x++) {
+//             for (int y = 400 + (x / 64) % 20; y < level_h; y++) ids[static_cast<size_t>(y) * level_w + x] = 1;
+//             if (x % 50 == 0) spawns.push_back(LevelSpawn{0, x * 32.0f, 380 * 32.0f, 0});
+//         }
+//         write_level("big.lvl", ids, level_w, level_h, ts, spawns);
+//     }
+//
+//     init_window(800, 600, "Level", 60);
+//     LevelFile level;
+//     if (!level.open("big.lvl")) return 1;              // Header only, instant at any size
+//     LevelStreamer streamer(level);
+//     std::vector<Obj> tiles;                             // img/tile/0.png ... 20.png, 32 x 32
+//     for (int id = 0; id <= 20; id++) tiles.emplace_back("img/tile/" + std::to_string(id) + ".png", 0, 0, 1.0f);
+//
+//     float camera_x = 0.0f, camera_y = 380 * ts;
+//     while (!window_should_close()) {
+//         camera_x += 8.0f;
+//         streamer.update(camera_x, camera_y, 800, 600);
+//
+//         start_drawing();
+//         clear_screen(COLOR_WHITE);
+//         int tx0 = static_cast<int>(camera_x) / ts, ty0 = static_cast<int>(camera_y) / ts;
+//         for (int ty = ty0; ty <= ty0 + 600 / ts; ty++) {
+//             for (int tx = tx0; tx <= tx0 + 800 / ts; tx++) {
+//                 int id = streamer.tile_at(tx, ty);
+//                 if (id < 0 || id >= static_cast<int>(tiles.size())) continue;
+//                 tiles[id].x = static_cast<int>(tx * ts - camera_x);
+//                 tiles[id].y = static_cast<int>(ty * ts - camera_y);
+//                 tiles[id].draw();
+//             }
+//         }
+//         stop_drawing();
+//         printf("resident %zu chunks, %zu loads, %zu frees\r", streamer.resident_count(), streamer.loads(), streamer.frees());
+//     }
+//
+//     quit_window();
+//     return 0;
+// }
+
+#endif // LEVEL_HPP
@@ -0,0 +1,130 @@
+#ifndef MASK_HPP
+#define MASK_HPP
+
+/**
+ * @file mask.hpp
+ * @brief 1-bit collision masks built from a texture's alpha map (see alpha.hpp), one bit per
+ *  screen pixel, packed 64 to a word. Two masks are tested by ANDing row words after
+ *  their rects are found to overlap, so a hit test is a few hundred bit operations at most.
+ *
+ *  Obj / Obj_ss build one mask per frame with build_masks() and pixel_overlap(a, b) tests them;
+ *  masks follow the object's scale and flip (a frame's mask is made again the first time it is
+ *  tested after either changed), rotation is not taken into account.
+ */
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include "alpha.hpp"
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define HEAVY_MASK_SSE2 1
+#endif
+
+//--------------------------CLASS COLLISIONMASK----------------------------------------
+
+/**
+ * @class CollisionMask
+ * @brief Solid pixels of one frame. Bit (x & 63) of word x / 64 in row y is pixel (x, y).
+ */
+class CollisionMask {
+public:
+    int width, height;
+    int words_per_row;
+    std::vector<uint64_t> bits;
+    float scale;            // What the mask was built with, to tell when it is out of date
+    uint8_t flip;
+    uint8_t threshold;
+
+    CollisionMask() : width(0), height(0), words_per_row(0), scale(1.0f), flip(0), threshold(128) {}
+
+    /**
+     * @brief Mask for the region (x, y, w, h) of an alpha map, drawn scale times bigger with the
+     *  given Flip bits (1 horizontal, 2 vertical). Pixels with alpha >= threshold are solid.
+     */
+    CollisionMask(const AlphaMap& alpha, int x, int y, int w, int h,
+                  float scale = 1.0f, uint8_t flip = 0, uint8_t threshold = 128)
+        : width(static_cast<int>(w * scale)), height(static_cast<int>(h * scale)), words_per_row(0),
+          scale(scale), flip(flip), threshold(threshold) {
+        if (width <= 0 || height <= 0 || alpha.empty()) {
+            width = height = 0;
+            return;
+        }
+        words_per_row = (width + 63) / 64;
+        bits.assign(static_cast<size_t>(words_per_row) * height, 0);
+
+        for (int row = 0; row < height; row++) {
+            int sy = row * h / height;                          // Nearest source row
+            if (flip & 2) sy = h - 1 - sy;
+            sy += y;
+            if (sy < 0 || sy >= alpha.height) continue;
+            uint64_t* out = &bits[static_cast<size_t>(row) * words_per_row];
+            for (int col = 0; col < width; col++) {
+                int sx = col * w / width;
+                if (flip & 1) sx = w - 1 - sx;
+                sx += x;
+                if (sx < 0 || sx >= alpha.width) continue;
+                if (alpha.at(sx, sy) >= threshold) out[col >> 6] |= 1ull << (col & 63);
+            }
+        }
+    }
+
+    bool empty() const { return bits.empty(); }
+
+    bool solid(int x, int y) const {
+        if (x < 0 || y < 0 || x >= width || y >= height) return false;
+        return (bits[static_cast<size_t>(y) * words_per_row + (x >> 6)] >> (x & 63)) & 1;
+    }
+
+    // 64 bits of row y starting at column start (may be negative), zero outside the mask
+    uint64_t row_bits(int y, int start) const {
+        const uint64_t* row = &bits[static_cast<size_t>(y) * words_per_row];
+        int word = start >> 6;              // Arithmetic shift rounds down for negative starts
+        int shift = start & 63;
+        uint64_t low = (word >= 0 && word < words_per_row) ? row[word] : 0;
+        uint64_t high = (word + 1 >= 0 && word + 1 < words_per_row) ? row[word + 1] : 0;
+        // Bits past the right edge are never set, so they read as zero too
+        return shift ? (low >> shift) | (high << (64 - shift)) : low;
+    }
+};
+
+//--------------------------OVERLAP TEST-----------------------------------------------
+
+/**
+ * @brief True if mask a at (ax, ay) and mask b at (bx, by) share a solid pixel.
+ *  The rects are checked first; then for every row they share, the words of a in the shared
+ *  columns are ANDed with b's row shifted into a's columns (two words at a time with SSE2).
+ */
+inline bool masks_overlap(const CollisionMask& a, int ax, int ay, const CollisionMask& b, int bx, int by) {
+    if (a.empty() || b.empty()) return false;
+    int left = ax > bx ? ax : bx;
+    int right = ax + a.width < bx + b.width ? ax + a.width : bx + b.width;
+    int top = ay > by ? ay : by;
+    int bottom = ay + a.height < by + b.height ? ay + a.height : by + b.height;
+    if (left >= right || top >= bottom) return false;
+
+    int first_word = (left - ax) >> 6;
+    int last_word = (right - 1 - ax) >> 6;
+    int dx = bx - ax;                       // b's column 0 in a's columns
+
+    for (int y = top; y < bottom; y++) {
+        const uint64_t* row_a = &a.bits[static_cast<size_t>(y - ay) * a.words_per_row];
+        int row_b = y - by;
+        int w = first_word;
+#ifdef HEAVY_MASK_SSE2
+        for (; w + 1 <= last_word; w += 2) {
+            __m128i wa = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row_a + w));
+            __m128i wb = _mm_set_epi64x(static_cast<long long>(b.row_bits(row_b, (w + 1) * 64 - dx)),
+                                        static_cast<long long>(b.row_bits(row_b, w * 64 - dx)));
+            __m128i both = _mm_and_si128(wa, wb);
+            if (_mm_movemask_epi8(_mm_cmpeq_epi8(both, _mm_setzero_si128())) != 0xFFFF) return true;
+        }
+#endif
+        for (; w <= last_word; w++) {
+            if (row_a[w] & b.row_bits(row_b, w * 64 - dx)) return true;
+        }
+    }
+    return false;
+}
+
+#endif // MASK_HPP
@@ -0,0 +1,126 @@
+#ifndef RESOLUTION_HPP
+#define RESOLUTION_HPP
+
+/**
+ * @file resolution.hpp
+ * @brief Shared parts of logical-resolution rendering. Each backend's set_logical_resolution(w, h)
+ *  makes the game draw into an offscreen target of that size, and stop_drawing scales it up to the
+ *  window once, nearest-neighbour, by a whole factor when the window is big enough.
+ *
+ *  set_render_scale(s) shrinks the target to s times the logical size while the game keeps drawing
+ *  in logical coordinates; ResolutionController picks s from measured frame times.
+ */
+#include <cstddef>
+#include <cmath>
+
+//--------------------------UPSCALE RECT-----------------------------------------------
+
+// Where a log_w x log_h image goes in the window: the largest whole multiple that fits
+// (or plain aspect fit if the window is smaller), centered
+inline void fit_logical(int win_w, int win_h, int log_w, int log_h, int& x, int& y, int& w, int& h) {
+    if (log_w <= 0 || log_h <= 0) {
+        x = y = 0;
+        w = win_w;
+        h = win_h;
+        return;
+    }
+    int factor_x = win_w / log_w, factor_y = win_h / log_h;
+    int factor = factor_x < factor_y ? factor_x : factor_y;
+    if (factor >= 1) {
+        w = log_w * factor;
+        h = log_h * factor;
+    } else if (static_cast<long long>(win_w) * log_h < static_cast<long long>(win_h) * log_w) {
+        w = win_w;
+        h = static_cast<int>(static_cast<long long>(win_w) * log_h / log_w);
+    } else {
+        h = win_h;
+        w = static_cast<int>(static_cast<long long>(win_h) * log_w / log_h);
+    }
+    x = (win_w - w) / 2;
+    y = (win_h - h) / 2;
+}
+
+// Window pixel (e.g. the mouse) to logical coordinates, the inverse of fit_logical
+inline void window_to_logical(int win_w, int win_h, int log_w, int log_h, int& x, int& y) {
+    if (log_w <= 0 || log_h <= 0) return;
+    int fx, fy, fw, fh;
+    fit_logical(win_w, win_h, log_w, log_h, fx, fy, fw, fh);
+    if (fw <= 0 || fh <= 0) return;
+    x = static_cast<int>(std::floor((x - fx) * static_cast<double>(log_w) / fw));     // Outside stays outside
+    y = static_cast<int>(std::floor((y - fy) * static_cast<double>(log_h) / fh));
+}
+
+//--------------------------CLASS RESOLUTIONCONTROLLER---------------------------------
+
+/**
+ * @class ResolutionController
+ * @brief Holds a frame budget by trading render resolution for time.
+ *
+ * The frame time is smoothed, and the scale only moves one step at a time with a pause after
+ * each change, so a single slow frame (loading, a GC in a script) doesn't make the picture pump.
+ *
+ *  ResolutionController controller(16.6f);
+ *  ...each frame, after stop_drawing():
+ *  set_render_scale(controller.update(last_frame_ms()));
+ */
+class ResolutionController {
+public:
+    explicit ResolutionController(float budget_ms, float min_scale = 0.5f, float max_scale = 1.0f,
+                                  float step = 0.1f, int settle_frames = 30)
+        : budget(budget_ms), low(min_scale), high(max_scale), step_size(step), settle(settle_frames),
+          current(max_scale), average(0.0f), cooldown(0), samples(0) {}
+
+    // Feed the last frame's time; returns the render scale to use from now on
+    float update(float frame_ms) {
+        average = samples++ == 0 ? frame_ms : average * 0.9f + frame_ms * 0.1f;
+        if (cooldown > 0) {
+            cooldown--;
+            return current;
+        }
+
+        if (average > budget * 1.05f && current > low) {
+            current = current - step_size < low ? low : current - step_size;
+            cooldown = settle;
+        } else if (average < budget * 0.75f && current < high) {
+            current = current + step_size > high ? high : current + step_size;
+            cooldown = settle;
+        }
+        return current;
+    }
+
+    float scale() const { return current; }
+    float average_ms() const { return average; }
+
+private:
+    float budget;           // Target frame time in milliseconds
+    float low, high;        // Scale range
+    float step_size;        // Scale change per adjustment
+    int settle;             // Frames to wait after a change before judging again
+    float current;
+    float average;          // Smoothed frame time
+    int cooldown;
+    size_t samples;
+};
+
+//--------------------------MAIN-----------------------------------------------------
+//
+// int main() {
+//     init_window(1280, 720, "Pixel Game", 60);
+//     set_logical_resolution(320, 180);                   // Drawn 4x, nearest-neighbour
+//
+//     Obj_ss hero("img/Attack1.png", 100, 40, 0.5f, 126, 126, 7, 0.1f);
+//     ResolutionController controller(16.6f);             // Only matters for big logical sizes
+//
+//     while (!window_should_close()) {
+//         start_drawing();
+//         clear_screen(COLOR_WHITE);
+//         hero.render(1.0f / 60.0f);
+//         stop_drawing();
+//         set_render_scale(controller.update(last_frame_ms()));
+//     }
+//
+//     quit_window();
+//     return 0;
+// }
+
+#endif // RESOLUTION_HPP
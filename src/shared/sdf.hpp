@@ -0,0 +1,283 @@
+#ifndef SDF_HPP
+#define SDF_HPP
+
+/**
+ * @file sdf.hpp
+ * @brief Signed-distance-field text. The font is rasterized once at a base size (48 px by
+ *  default), every glyph is turned into a distance field, and the fields are packed into one
+ *  atlas. Any text size or zoom is then drawn from that atlas: a texel holds how far it is
+ *  from the glyph's edge, and the shader cuts the edge at 0.5 with a one-pixel smooth step,
+ *  so large text stays sharp and atlas memory doesn't grow with the number of sizes used.
+ *
+ *  The field follows TinySDF: a Felzenszwalb distance transform seeded with sub-pixel
+ *  distances from the anti-aliased coverage, so edges stay smooth at the base size.
+ *
+ *  Include it after text.hpp; the backend policy adds:
+ *
+ *      typedef ... SdfAtlas;
+ *      static bool rasterize_font(const std::string& path, int size, std::vector<uint8_t>& coverage,
+ *                                 int& width, int& height, FontMetrics& metrics);  // Glyphs on the CPU
+ *      static SdfAtlas create_sdf_atlas(const uint8_t* field, int width, int height, float spread);
+ *      static void destroy_sdf_atlas(SdfAtlas atlas);
+ *      static void draw_sdf_glyphs(SdfAtlas atlas, const TextLayout& layout, float x, float y,
+ *                                  float scale, Color color);
+ *
+ *  raylib and SFML draw the field with a fragment shader. SDL's renderer has no shaders, so it
+ *  resolves the field into coverage textures on the CPU (sdf_coverage). Those come in quarter-
+ *  octave steps, a few kept at once, and sizes in between are filtered down from the next step
+ *  up; that's still no font rasterizing, but it does cost a texture per step in use.
+ */
+#include <string>
+#include <vector>
+#include <cmath>
+#include <cstdint>
+#include <cstddef>
+#include "text.hpp"
+
+//--------------------------DISTANCE TRANSFORM-----------------------------------------
+
+// Squared distance transform of one row or column in place (Felzenszwalb & Huttenlocher)
+inline void edt_1d(float* grid, int offset, int stride, int length, float* f, int* v, float* z) {
+    const float inf = 1e20f;
+    v[0] = 0;
+    z[0] = -inf;
+    z[1] = inf;
+    f[0] = grid[offset];
+    for (int q = 1, k = 0; q < length; q++) {
+        f[q] = grid[offset + q * stride];
+        float s;
+        do {
+            int r = v[k];
+            s = (f[q] - f[r] + static_cast<float>(q) * q - static_cast<float>(r) * r) / (q - r) / 2;
+        } while (s <= z[k] && --k > -1);
+        k++;
+        v[k] = q;
+        z[k] = s;
+        z[k + 1] = inf;
+    }
+    for (int q = 0, k = 0; q < length; q++) {
+        while (z[k + 1] < q) k++;
+        int r = v[k];
+        grid[offset + q * stride] = f[r] + static_cast<float>(q - r) * (q - r);
+    }
+}
+
+inline void edt_2d(float* grid, int width, int height, float* f, int* v, float* z) {
+    for (int x = 0; x < width; x++) edt_1d(grid, x, width, height, f, v, z);
+    for (int y = 0; y < height; y++) edt_1d(grid, y * width, 1, width, f, v, z);
+}
+
+//--------------------------SDF ATLAS--------------------------------------------------
+
+/**
+ * @brief Turn a coverage atlas (one byte per texel, glyph rects in metrics) into a distance
+ *  field atlas. Each glyph gets spread + 1 pixels of border so the field can fall off around
+ *  it; metrics is updated to point at the new rects. 255 is deep inside, 0 is spread pixels
+ *  or more outside, and the edge sits at 128.
+ */
+inline void build_sdf_atlas(const std::vector<uint8_t>& coverage, int width, int height, FontMetrics& metrics,
+                            int spread, std::vector<uint8_t>& field, int& field_width, int& field_height) {
+    const float inf = 1e20f;
+    const int atlas_width = 512;
+    int pad = spread + 1;
+
+    // Place the padded glyphs first, in rows
+    TexRect placed[95];
+    int x = 0, y = 0, row_height = 0;
+    for (int i = 0; i < 95; i++) {
+        const TexRect& src = metrics.glyphs[i].src;
+        placed[i] = TexRect{0, 0, 0, 0};
+        if (src.w <= 0 || src.h <= 0) continue;
+        int w = src.w + pad * 2, h = src.h + pad * 2;
+        if (x + w > atlas_width) {
+            x = 0;
+            y += row_height;
+            row_height = 0;
+        }
+        placed[i] = TexRect{x, y, w, h};
+        x += w;
+        if (h > row_height) row_height = h;
+    }
+    field_width = atlas_width;
+    field_height = y + row_height;
+    field.assign(static_cast<size_t>(field_width) * field_height, 0);
+
+    std::vector<float> outer, inner, f;
+    std::vector<int> v;
+    std::vector<float> z;
+    for (int i = 0; i < 95; i++) {
+        AtlasGlyph& glyph = metrics.glyphs[i];
+        const TexRect& box = placed[i];
+        if (box.w == 0) continue;
+
+        // Seed both transforms with sub-pixel distances from the coverage
+        size_t cells = static_cast<size_t>(box.w) * box.h;
+        outer.assign(cells, inf);
+        inner.assign(cells, 0.0f);
+        for (int row = 0; row < glyph.src.h; row++) {
+            int sy = glyph.src.y + row;
+            if (sy < 0 || sy >= height) continue;
+            for (int col = 0; col < glyph.src.w; col++) {
+                int sx = glyph.src.x + col;
+                if (sx < 0 || sx >= width) continue;
+                float a = coverage[static_cast<size_t>(sy) * width + sx] / 255.0f;
+                size_t j = static_cast<size_t>(row + pad) * box.w + col + pad;
+                if (a >= 1.0f) {
+                    outer[j] = 0.0f;
+                    inner[j] = inf;
+                } else if (a > 0.0f) {
+                    float o = 0.5f - a > 0.0f ? 0.5f - a : 0.0f;
+                    float n = a - 0.5f > 0.0f ? a - 0.5f : 0.0f;
+                    outer[j] = o * o;
+                    inner[j] = n * n;
+                }
+            }
+        }
+        int longest = box.w > box.h ? box.w : box.h;
+        f.resize(longest);
+        v.resize(longest);
+        z.resize(longest + 1);
+        edt_2d(outer.data(), box.w, box.h, f.data(), v.data(), z.data());
+        edt_2d(inner.data(), box.w, box.h, f.data(), v.data(), z.data());
+
+        for (int row = 0; row < box.h; row++) {
+            uint8_t* out = &field[static_cast<size_t>(box.y + row) * field_width + box.x];
+            for (int col = 0; col < box.w; col++) {
+                size_t j = static_cast<size_t>(row) * box.w + col;
+                float d = std::sqrt(outer[j]) - std::sqrt(inner[j]);       // > 0 outside the glyph
+                float value = 0.5f - d / (2.0f * spread);
+                value = value < 0.0f ? 0.0f : (value > 1.0f ? 1.0f : value);
+                out[col] = static_cast<uint8_t>(value * 255.0f + 0.5f);
+            }
+        }
+
+        glyph.src = box;
+        glyph.off_x -= pad;
+        glyph.off_y -= pad;
+    }
+}
+
+/**
+ * @brief Resolve a distance field atlas into plain coverage at scale times its size (for
+ *  renderers without shaders). The edge gets the same one-pixel smooth step the shaders use.
+ */
+inline void sdf_coverage(const uint8_t* field, int width, int height, float spread, float scale,
+                         std::vector<uint8_t>& out, int& out_width, int& out_height) {
+    out_width = static_cast<int>(std::ceil(width * scale));
+    out_height = static_cast<int>(std::ceil(height * scale));
+    out.assign(static_cast<size_t>(out_width) * out_height, 0);
+    for (int oy = 0; oy < out_height; oy++) {
+        float fy = (oy + 0.5f) / scale - 0.5f;
+        int y0 = static_cast<int>(std::floor(fy));
+        float ty = fy - y0;
+        int y1 = y0 + 1;
+        y0 = y0 < 0 ? 0 : (y0 >= height ? height - 1 : y0);
+        y1 = y1 < 0 ? 0 : (y1 >= height ? height - 1 : y1);
+        for (int ox = 0; ox < out_width; ox++) {
+            float fx = (ox + 0.5f) / scale - 0.5f;
+            int x0 = static_cast<int>(std::floor(fx));
+            float tx = fx - x0;
+            int x1 = x0 + 1;
+            x0 = x0 < 0 ? 0 : (x0 >= width ? width - 1 : x0);
+            x1 = x1 < 0 ? 0 : (x1 >= width ? width - 1 : x1);
+            float top = field[y0 * width + x0] * (1 - tx) + field[y0 * width + x1] * tx;
+            float bottom = field[y1 * width + x0] * (1 - tx) + field[y1 * width + x1] * tx;
+            float value = (top * (1 - ty) + bottom * ty) / 255.0f;
+
+            float d = (0.5f - value) * 2.0f * spread * scale;           // Output pixels outside the edge
+            float a = 0.5f - d;
+            a = a < 0.0f ? 0.0f : (a > 1.0f ? 1.0f : a);
+            out[static_cast<size_t>(oy) * out_width + ox] = static_cast<uint8_t>(a * 255.0f + 0.5f);
+        }
+    }
+}
+
+//--------------------------CLASS SDFFONT----------------------------------------------
+
+/**
+ * @class BasicSdfFont
+ * @brief One distance field atlas for every size of a font. Each backend typedefs it as SdfFont.
+ *  Layouts are made at the base size and cached like TextFont's; drawing scales the quads.
+ *
+ *  SdfFont font("FreeMono.ttf");
+ *  font.draw("Game Over", 100, 80, 96.0f, COLOR_RED);
+ *  font.draw("press any key", 100, 200, 18.0f, COLOR_BLACK);
+ */
+template <class Backend>
+class BasicSdfFont {
+public:
+    typedef typename Backend::SdfAtlas SdfAtlas;
+
+    explicit BasicSdfFont(const std::string& path, int base_size = 48, int spread = 6)
+        : atlas(nullptr), font_id(next_font_id()) {
+        std::vector<uint8_t> coverage;
+        int width = 0, height = 0;
+        metrics = FontMetrics();
+        if (!Backend::rasterize_font(path, base_size, coverage, width, height, metrics)) {
+            throw std::runtime_error("Failed to load font: " + path);
+        }
+        std::vector<uint8_t> field;
+        int field_width = 0, field_height = 0;
+        build_sdf_atlas(coverage, width, height, metrics, spread, field, field_width, field_height);
+        atlas = Backend::create_sdf_atlas(field.data(), field_width, field_height, static_cast<float>(spread));
+        if (!atlas) throw std::runtime_error("Failed to create SDF atlas: " + path);
+    }
+
+    ~BasicSdfFont() {
+        if (atlas) Backend::destroy_sdf_atlas(atlas);
+    }
+
+    BasicSdfFont(const BasicSdfFont&) = delete;
+    BasicSdfFont& operator=(const BasicSdfFont&) = delete;
+
+    // Layout at the base size; wrap_width is in pixels at the given size
+    const TextLayout& layout(const std::string& text, float size, float wrap_width = 0.0f) const {
+        float scale = size / metrics.size;
+        return text_layout_cache().get(metrics, font_id, text, wrap_width > 0.0f ? wrap_width / scale : 0.0f);
+    }
+
+    void measure(const std::string& text, float size, float& width, float& height, float wrap_width = 0.0f) const {
+        float scale = size / metrics.size;
+        const TextLayout& laid_out = layout(text, size, wrap_width);
+        width = laid_out.width * scale;
+        height = laid_out.height * scale;
+    }
+
+    void draw(const std::string& text, float x, float y, float size, Color color, float wrap_width = 0.0f) const {
+        const TextLayout& laid_out = layout(text, size, wrap_width);
+        if (!laid_out.quads.empty()) Backend::draw_sdf_glyphs(atlas, laid_out, x, y, size / metrics.size, color);
+    }
+
+    int base_size() const { return metrics.size; }
+    float line_height(float size) const { return metrics.line_height * size / metrics.size; }
+
+private:
+    SdfAtlas atlas;
+    FontMetrics metrics;        // At the base size, rects in the distance field atlas
+    uint32_t font_id;
+};
+
+//--------------------------MAIN-----------------------------------------------------
+//
+// The same atlas at sizes from 8 to 160 px while zooming; nothing is rasterized after loading.
+//
+// int main() {
+//     init_window(800, 600, "SDF", 60);
+//     SdfFont font("FreeMono.ttf");
+//
+//     float t = 0.0f;
+//     while (!window_should_close()) {
+//         t += 1.0f / 60.0f;
+//         float zoom = 8.0f + 152.0f * (0.5f + 0.5f * std::sin(t));
+//         start_drawing();
+//         clear_screen(COLOR_WHITE);
+//         font.draw("Heavy", 20, 20, zoom, COLOR_BLACK);
+//         font.draw("Small print stays readable at 12 px", 20, 560, 12.0f, COLOR_DARK_GRAY);
+//         stop_drawing();
+//     }
+//
+//     quit_window();
+//     return 0;
+// }
+
+#endif // SDF_HPP
@@ -0,0 +1,170 @@
+#ifndef SIGHT_HPP
+#define SIGHT_HPP
+
+/**
+ * @file sight.hpp
+ * @brief Line of sight over a TileGrid. A ray walks the tiles it crosses one by one
+ *  (Amanatides & Woo's grid traversal) and stops at the first solid tile, so a check costs
+ *  the length of the ray in tiles, not the number of objects in the level. Checks are batched:
+ *  a whole array of rays goes in, one visible flag per ray comes out, split across threads
+ *  when a JobSystem is given.
+ *
+ *  Every tile the segment touches counts, the end tiles included; a ray through the exact
+ *  corner between two tiles is blocked if either side tile is solid, like a body would be.
+ */
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <cmath>
+#include <utility>
+#include "tilemap.hpp"
+#include "job.hpp"
+
+//--------------------------SIGHT RAY--------------------------------------------------
+
+struct SightRay {
+    float x0, y0;           // From, in pixels (the enemy's eyes)
+    float x1, y1;           // To, in pixels (the player)
+};
+
+//--------------------------LINE OF SIGHT----------------------------------------------
+
+/**
+ * @brief True if no solid tile lies between (x0, y0) and (x1, y1). When blocked and hit_tx is
+ *  given, the first solid tile on the way is stored in hit_tx, hit_ty.
+ */
+inline bool line_of_sight(const TileGrid& grid, float x0, float y0, float x1, float y1,
+                          int* hit_tx = nullptr, int* hit_ty = nullptr) {
+    const float ts = static_cast<float>(grid.tile_size);
+    int tx = tile_floor(x0, grid.tile_size), ty = tile_floor(y0, grid.tile_size);
+    int end_x = tile_floor(x1, grid.tile_size), end_y = tile_floor(y1, grid.tile_size);
+
+    // Along one row the bits can be tested 64 tiles at a time
+    if (ty == end_y) {
+        int lo = tx < end_x ? tx : end_x, hi = tx < end_x ? end_x : tx;
+        int first = tx <= end_x ? grid.row_first(ty, lo, hi) : grid.row_last(ty, lo, hi);
+        if (first < lo || first > hi) return true;
+        if (hit_tx) {
+            *hit_tx = first;
+            *hit_ty = ty;
+        }
+        return false;
+    }
+
+    // Always walked from the same end, so whether A sees B never depends on who asks
+    bool reversed = x1 < x0 || (x1 == x0 && y1 < y0);
+    if (reversed) {
+        std::swap(x0, x1);
+        std::swap(y0, y1);
+        std::swap(tx, end_x);
+        std::swap(ty, end_y);
+    }
+
+    // Where the ray crosses the next vertical / horizontal tile edge, as a fraction of the
+    // segment. Worked out from the edge each time rather than summed, so corners are found
+    // exactly however long the ray
+    double dx = static_cast<double>(x1) - x0, dy = static_cast<double>(y1) - y0;
+    int step_x = dx > 0.0 ? 1 : -1, step_y = dy > 0.0 ? 1 : -1;
+    double inv_dx = dx != 0.0 ? 1.0 / dx : 0.0, inv_dy = 1.0 / dy;
+    auto cross_x = [&](int col) { return dx != 0.0 ? ((col + (step_x > 0)) * static_cast<double>(ts) - x0) * inv_dx : INFINITY; };
+    auto cross_y = [&](int row) { return ((row + (step_y > 0)) * static_cast<double>(ts) - y0) * inv_dy; };
+    const double corner = 1e-9;         // Closer than this counts as through the corner
+
+    bool hit = false;
+    auto solid = [&](int bx, int by) {
+        if (!grid.is_solid(bx, by)) return false;
+        hit = true;
+        if (hit_tx) {
+            *hit_tx = bx;
+            *hit_ty = by;
+        }
+        // Walking backwards, the last solid tile is the first one seen from the caller's end
+        return !(reversed && hit_tx);
+    };
+
+    // Exactly this many steps reach the end tile
+    int steps = std::abs(end_x - tx) + std::abs(end_y - ty);
+    double next_x = cross_x(tx), next_y = cross_y(ty);
+    for (;;) {
+        if (solid(tx, ty)) return false;
+        if (steps == 0) return !hit;
+        if (tx != end_x && ty != end_y && std::fabs(next_x - next_y) <= corner) {
+            // Through a corner: either side tile blocks, like it would block a body
+            if (solid(tx + step_x, ty) || solid(tx, ty + step_y)) return false;
+            tx += step_x;
+            ty += step_y;
+            next_x = cross_x(tx);
+            next_y = cross_y(ty);
+            steps -= 2;
+            continue;
+        }
+        steps--;
+        if (tx != end_x && (ty == end_y || next_x < next_y)) {
+            tx += step_x;
+            next_x = cross_x(tx);
+        } else {
+            ty += step_y;
+            next_y = cross_y(ty);
+        }
+    }
+}
+
+// One flag per ray, 1 if it reaches its end
+inline void line_of_sight(const TileGrid& grid, const SightRay* rays, size_t count, uint8_t* visible) {
+    for (size_t i = 0; i < count; i++) {
+        const SightRay& r = rays[i];
+        visible[i] = line_of_sight(grid, r.x0, r.y0, r.x1, r.y1) ? 1 : 0;
+    }
+}
+
+// The same, split across the job system; worth it from a few thousand rays a frame
+inline void line_of_sight(JobSystem& jobs, const TileGrid& grid, const SightRay* rays, size_t count, uint8_t* visible) {
+    jobs.parallel_for(0, count, 1024, [&](size_t begin, size_t end) {
+        line_of_sight(grid, rays + begin, end - begin, visible + begin);
+    });
+}
+
+//--------------------------MAIN-----------------------------------------------------
+// Benchmark: every enemy checks whether it sees the player, 1k to 20k enemies per frame on a
+// 256 x 256 level. Build with -O2 -pthread.
+//
+// #include <chrono>
+// #include <cstdio>
+// #include <random>
+//
+// int main() {
+//     const int size = 256, ts = 16, frames = 200;
+//     std::vector<int> ids(size * size, -1);
+//     std::mt19937 rng(11);
+//     for (int i = 0; i < size * size / 20; i++) ids[rng() % (size * size)] = 1;     // 5% walls
+//     TileGrid grid(ids, size, size, ts);
+//     JobSystem jobs;
+//
+//     for (size_t count : {1000u, 5000u, 20000u}) {
+//         std::vector<SightRay> rays(count);
+//         std::vector<uint8_t> visible(count);
+//         double single_ms = 0.0, jobs_ms = 0.0;
+//         size_t seen = 0, one_way = 0;
+//         for (int f = 0; f < frames; f++) {
+//             float px = float(rng() % (size * ts)), py = float(rng() % (size * ts));
+//             for (SightRay& r : rays) r = SightRay{float(rng() % (size * ts)), float(rng() % (size * ts)), px, py};
+//             auto t0 = std::chrono::steady_clock::now();
+//             line_of_sight(grid, rays.data(), count, visible.data());
+//             auto t1 = std::chrono::steady_clock::now();
+//             line_of_sight(jobs, grid, rays.data(), count, visible.data());
+//             auto t2 = std::chrono::steady_clock::now();
+//             single_ms += std::chrono::duration<double, std::milli>(t1 - t0).count();
+//             jobs_ms += std::chrono::duration<double, std::milli>(t2 - t1).count();
+//             for (uint8_t v : visible) seen += v;
+//             for (size_t i = 0; i < count; i++) {                                    // Sight is mutual
+//                 const SightRay& r = rays[i];
+//                 if (line_of_sight(grid, r.x1, r.y1, r.x0, r.y0) != (visible[i] != 0)) one_way++;
+//             }
+//         }
+//         std::printf("%6zu rays: %.3f ms/frame, %.3f ms/frame on %u threads (%.0f%% visible, %zu one-way)\n", count,
+//                     single_ms / frames, jobs_ms / frames, jobs.size(), 100.0 * seen / (count * frames), one_way);
+//     }
+//     return 0;
+// }
+
+#endif // SIGHT_HPP
@@ -0,0 +1,304 @@
+#ifndef TEXT_HPP
+#define TEXT_HPP
+
+/**
+ * @file text.hpp
+ * @brief Measured, wrapped text drawn from a glyph atlas. A TextFont rasterizes the printable
+ *  ASCII glyphs of a font once into one texture; a string is laid out into positioned glyph
+ *  quads once and the layout is cached, keyed by the string, font, size and wrap width. Drawing
+ *  a cached layout is a single batched submission of its quads, with no rasterizing, measuring
+ *  or allocation, so dialogue that stays on screen costs next to nothing after its first frame.
+ *
+ *  Include it after core.hpp; the backend policy adds:
+ *
+ *      static bool load_font_atlas(const std::string& path, int size, Texture& out, FontMetrics& metrics);
+ *      static void draw_glyphs(Texture atlas, const TextLayout& layout, float x, float y, Color color);
+ *
+ *  load_font_atlas fills one AtlasGlyph per printable ASCII character; draw_glyphs draws every
+ *  quad of a layout tinted with color, batched into as few draw calls as the backend allows.
+ */
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <algorithm>
+#include <cstdint>
+#include <cstddef>
+#include "core.hpp"
+
+//--------------------------FONT METRICS-----------------------------------------------
+
+// One glyph in the atlas, placed relative to the pen at the top of its line
+struct AtlasGlyph {
+    TexRect src;            // Atlas pixels, w == 0 for blanks
+    float off_x, off_y;     // Top-left of the quad from the pen position
+    float advance;          // Pen movement after the glyph
+};
+
+struct FontMetrics {
+    int size;               // Pixel size the atlas was rasterized at
+    float line_height;      // Distance between baselines
+    AtlasGlyph glyphs[95];  // ' ' to '~'; anything else is drawn as '?'
+
+    const AtlasGlyph& glyph(unsigned char c) const {
+        return glyphs[(c >= 32 && c < 127 ? c : '?') - 32];
+    }
+};
+
+//--------------------------TEXT LAYOUT------------------------------------------------
+
+struct GlyphQuad {
+    TexRect src;
+    float x, y, w, h;       // Relative to the layout's top-left
+};
+
+struct TextLayout {
+    std::vector<GlyphQuad> quads;
+    float width, height;    // Size of the laid-out block, trailing spaces not counted
+    int lines;
+};
+
+/**
+ * @brief Lay text out line by line. Lines break at '\n' and, with wrap_width > 0, at the last
+ *  space that keeps them inside wrap_width; a word longer than a whole line is broken inside.
+ *  Spaces at a wrap point are dropped.
+ */
+inline void layout_text(const FontMetrics& font, const std::string& text, float wrap_width, TextLayout& out) {
+    out.quads.clear();
+    out.width = 0.0f;
+    out.lines = 1;
+
+    float pen_x = 0.0f, pen_y = 0.0f;
+    float pending_space = 0.0f;         // Spaces not placed yet, dropped if the line wraps
+    size_t i = 0, n = text.size();
+    while (i < n) {
+        unsigned char c = static_cast<unsigned char>(text[i]);
+        if (c == '\n') {
+            out.width = std::max(out.width, pen_x);
+            pen_x = 0.0f;
+            pen_y += font.line_height;
+            pending_space = 0.0f;
+            out.lines++;
+            i++;
+            continue;
+        }
+        if (c == ' ' || c == '\t') {
+            pending_space += font.glyph(' ').advance * (c == '\t' ? 4 : 1);
+            i++;
+            continue;
+        }
+
+        // Measure the word, then decide whether it starts a new line
+        size_t end = i;
+        float word = 0.0f;
+        while (end < n && text[end] != ' ' && text[end] != '\t' && text[end] != '\n') {
+            word += font.glyph(static_cast<unsigned char>(text[end])).advance;
+            end++;
+        }
+        bool wraps = wrap_width > 0.0f && pen_x > 0.0f && pen_x + pending_space + word > wrap_width;
+        if (wraps) {
+            out.width = std::max(out.width, pen_x);
+            pen_x = 0.0f;
+            pen_y += font.line_height;
+            out.lines++;
+        } else {
+            pen_x += pending_space;
+        }
+        pending_space = 0.0f;
+
+        for (; i < end; i++) {
+            const AtlasGlyph& g = font.glyph(static_cast<unsigned char>(text[i]));
+            if (wrap_width > 0.0f && pen_x > 0.0f && pen_x + g.advance > wrap_width) {
+                // Only a word wider than the whole line gets here
+                out.width = std::max(out.width, pen_x);
+                pen_x = 0.0f;
+                pen_y += font.line_height;
+                out.lines++;
+            }
+            if (g.src.w > 0) {
+                GlyphQuad quad = {g.src, pen_x + g.off_x, pen_y + g.off_y,
+                                  static_cast<float>(g.src.w), static_cast<float>(g.src.h)};
+                out.quads.push_back(quad);
+            }
+            pen_x += g.advance;
+        }
+    }
+    out.width = std::max(out.width, pen_x);
+    out.height = out.lines * font.line_height;
+}
+
+//--------------------------CLASS TEXTLAYOUTCACHE--------------------------------------
+
+/**
+ * @class TextLayoutCache
+ * @brief Layouts by (string, font, size, wrap width). Entries are found by a 64-bit hash and
+ *  the string is compared on a hit, so a lookup allocates nothing. When the cache is full the
+ *  least recently used quarter is dropped.
+ *
+ *  A returned layout stays valid until the next get() (which may evict it).
+ */
+class TextLayoutCache {
+public:
+    explicit TextLayoutCache(size_t max_entries = 1024)
+        : limit(max_entries < 4 ? 4 : max_entries), tick(0), hit_count(0), miss_count(0) {}
+
+    const TextLayout& get(const FontMetrics& font, uint32_t font_id, const std::string& text, float wrap_width) {
+        int wrap = wrap_width > 0.0f ? static_cast<int>(wrap_width) : 0;
+        uint64_t key = hash_key(text, font_id, font.size, wrap);
+        tick++;
+
+        auto found = entries.find(key);
+        if (found != entries.end() && found->second.font_id == font_id && found->second.size == font.size &&
+            found->second.wrap == wrap && found->second.text == text) {
+            found->second.last_use = tick;
+            hit_count++;
+            return found->second.layout;
+        }
+
+        miss_count++;
+        if (found == entries.end() && entries.size() >= limit) evict();
+        Entry& entry = entries[key];        // A hash collision simply replaces the older entry
+        entry.text = text;
+        entry.font_id = font_id;
+        entry.size = font.size;
+        entry.wrap = wrap;
+        entry.last_use = tick;
+        layout_text(font, text, static_cast<float>(wrap), entry.layout);
+        return entry.layout;
+    }
+
+    void clear() { entries.clear(); }
+    size_t size() const { return entries.size(); }
+    size_t hits() const { return hit_count; }
+    size_t misses() const { return miss_count; }
+
+private:
+    struct Entry {
+        std::string text;
+        uint32_t font_id;
+        int size;
+        int wrap;
+        uint64_t last_use;
+        TextLayout layout;
+    };
+
+    size_t limit;
+    uint64_t tick;
+    size_t hit_count, miss_count;
+    std::unordered_map<uint64_t, Entry> entries;
+
+    // FNV-1a over the string, then the rest of the key mixed in
+    static uint64_t hash_key(const std::string& text, uint32_t font_id, int size, int wrap) {
+        uint64_t h = 0xcbf29ce484222325ull;
+        for (char c : text) {
+            h ^= static_cast<unsigned char>(c);
+            h *= 0x100000001b3ull;
+        }
+        h ^= (static_cast<uint64_t>(font_id) << 40) ^ (static_cast<uint64_t>(static_cast<uint32_t>(size)) << 24) ^
+             static_cast<uint32_t>(wrap);
+        return h * 0x9E3779B97F4A7C15ull;
+    }
+
+    void evict() {
+        std::vector<uint64_t> stamps;
+        stamps.reserve(entries.size());
+        for (const auto& entry : entries) stamps.push_back(entry.second.last_use);
+        std::nth_element(stamps.begin(), stamps.begin() + stamps.size() / 4, stamps.end());
+        uint64_t cutoff = stamps[stamps.size() / 4];
+        for (auto it = entries.begin(); it != entries.end();) {
+            if (it->second.last_use <= cutoff) it = entries.erase(it);
+            else ++it;
+        }
+    }
+};
+
+// Cache shared by every TextFont
+inline TextLayoutCache& text_layout_cache() {
+    static TextLayoutCache cache;
+    return cache;
+}
+
+// Ids are never reused, so a new font can't hit an old font's layouts
+inline uint32_t next_font_id() {
+    static uint32_t id = 0;
+    return ++id;
+}
+
+//--------------------------CLASS TEXTFONT---------------------------------------------
+
+/**
+ * @class BasicTextFont
+ * @brief A font at one pixel size: its glyph atlas and metrics. Each backend typedefs it as TextFont.
+ *
+ *  TextFont dialog("FreeMono.ttf", 20);
+ *  dialog.draw(line, 40, 400, COLOR_BLACK, 560);      // Wrapped at 560 px
+ */
+template <class Backend>
+class BasicTextFont {
+public:
+    typedef typename Backend::Texture Texture;
+
+    BasicTextFont(const std::string& path, int size) : font_id(next_font_id()) {
+        Texture texture = nullptr;
+        metrics = FontMetrics();
+        if (!Backend::load_font_atlas(path, size, texture, metrics)) {
+            throw std::runtime_error("Failed to load font: " + path);
+        }
+        atlas.reset(texture);
+    }
+
+    // Laid out once per (text, wrap width), then served from text_layout_cache()
+    const TextLayout& layout(const std::string& text, float wrap_width = 0.0f) const {
+        return text_layout_cache().get(metrics, font_id, text, wrap_width);
+    }
+
+    void measure(const std::string& text, float& width, float& height, float wrap_width = 0.0f) const {
+        const TextLayout& laid_out = layout(text, wrap_width);
+        width = laid_out.width;
+        height = laid_out.height;
+    }
+
+    void draw(const std::string& text, float x, float y, Color color, float wrap_width = 0.0f) const {
+        const TextLayout& laid_out = layout(text, wrap_width);
+        if (!laid_out.quads.empty()) Backend::draw_glyphs(atlas.get(), laid_out, x, y, color);
+    }
+
+    int size() const { return metrics.size; }
+    float line_height() const { return metrics.line_height; }
+    const FontMetrics& font_metrics() const { return metrics; }
+
+private:
+    TextureHandle<Backend> atlas;
+    FontMetrics metrics;
+    uint32_t font_id;
+};
+
+//--------------------------MAIN-----------------------------------------------------
+//
+// A dialogue box: the first frame lays the text out, every later frame just draws the quads.
+//
+// int main() {
+//     init_window(800, 600, "Dialogue", 60);
+//     TextFont font("FreeMono.ttf", 20);
+//     std::string line = "The old lighthouse keeper looks up from his lamp. \"Nobody has come "
+//                        "this way in years,\" he says. \"Mind the stairs, the third one is loose.\"";
+//
+//     int frame = 0;
+//     while (!window_should_close()) {
+//         start_drawing();
+//         clear_screen(COLOR_WHITE);
+//         float w, h;
+//         font.measure(line, w, h, 560);
+//         draw_rect(30, 390, 580, static_cast<int>(h) + 20, COLOR_BLACK);
+//         font.draw(line, 40, 400, COLOR_WHITE, 560);
+//         stop_drawing();
+//
+//         if (++frame % 300 == 0) {
+//             printf("layouts: %zu hits, %zu misses\n", text_layout_cache().hits(), text_layout_cache().misses());
+//         }
+//     }
+//
+//     quit_window();
+//     return 0;
+// }
+
+#endif // TEXT_HPP
@@ -0,0 +1,264 @@
+#ifndef TILEMAP_HPP
+#define TILEMAP_HPP
+
+/**
+ * @file tilemap.hpp
+ * @brief Backend independent tile collision: a packed solidity bit grid for a level and
+ *  swept AABB movement that only touches the tiles a body actually crosses.
+ *  Works with any of the sdl / raylib / sfml headers, it does not draw anything.
+ */
+#include <vector>
+#include <cstdint>
+#include <cmath>
+
+//--------------------------TILE SOLIDITY----------------------------------------------
+
+// Solidity bitmask indexed by tile ID: bit n set means tile n (img/tile/n.png) is solid.
+// Default matches img/tile: 0-8 are ground and wall blocks, 9-20 are water, decoration,
+// pickups, spawns and the exit, which characters pass through.
+const uint64_t TILE_SOLID_DEFAULT = 0x1FFull;
+
+inline bool tile_is_solid(int tile_id, uint64_t solid_mask = TILE_SOLID_DEFAULT) {
+    return tile_id >= 0 && tile_id < 64 && ((solid_mask >> tile_id) & 1ull);
+}
+
+// Index of the lowest / highest set bit, v must not be 0
+inline int tile_bit_low(uint64_t v) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctzll(v);
+#else
+    int n = 0;
+    while (!(v & 1ull)) { v >>= 1; n++; }
+    return n;
+#endif
+}
+
+inline int tile_bit_high(uint64_t v) {
+#if defined(__GNUC__) || defined(__clang__)
+    return 63 - __builtin_clzll(v);
+#else
+    int n = 63;
+    while (!(v & (1ull << 63))) { v <<= 1; n--; }
+    return n;
+#endif
+}
+
+//--------------------------CLASS TILEGRID---------------------------------------------
+
+/**
+ * @class TileGrid
+ * @brief One bit per tile, packed 64 columns to a word, one run of words per row.
+ *
+ * Columns outside the grid count as solid so bodies can't walk off the sides of the level;
+ * rows above and below count as empty so bodies can jump out of the top or fall into pits.
+ */
+class TileGrid {
+public:
+    int width, height;              // Size in tiles
+    int tile_size;                  // Size of one tile in pixels
+    int words_per_row;              // uint64_t words per row
+    std::vector<uint64_t> bits;     // Row-major packed solidity bits
+
+    TileGrid(int w, int h, int size)
+        : width(w), height(h), tile_size(size), words_per_row((w + 63) / 64),
+          bits(static_cast<size_t>(words_per_row) * h, 0) {}
+
+    // Build from a row-major list of tile IDs (-1 for empty), like the level csv files
+    TileGrid(const std::vector<int>& tile_ids, int w, int h, int size, uint64_t solid_mask = TILE_SOLID_DEFAULT)
+        : TileGrid(w, h, size) {
+        for (int ty = 0; ty < h; ty++) {
+            for (int tx = 0; tx < w; tx++) {
+                size_t i = static_cast<size_t>(ty) * w + tx;
+                if (i < tile_ids.size() && tile_is_solid(tile_ids[i], solid_mask)) {
+                    set_solid(tx, ty, true);
+                }
+            }
+        }
+    }
+
+    void set_solid(int tx, int ty, bool solid) {
+        if (tx < 0 || tx >= width || ty < 0 || ty >= height) return;
+        uint64_t& word = bits[static_cast<size_t>(ty) * words_per_row + (tx >> 6)];
+        uint64_t bit = 1ull << (tx & 63);
+        word = solid ? (word | bit) : (word & ~bit);
+    }
+
+    bool is_solid(int tx, int ty) const {
+        if (tx < 0 || tx >= width) return true;
+        if (ty < 0 || ty >= height) return false;
+        return (bits[static_cast<size_t>(ty) * words_per_row + (tx >> 6)] >> (tx & 63)) & 1ull;
+    }
+
+    // Lowest solid column in [tx0, tx1] on row ty, or tx1 + 1 if the span is clear
+    int row_first(int ty, int tx0, int tx1) const {
+        if (tx0 > tx1) return tx1 + 1;
+        if (tx0 < 0) return tx0;
+        int last = tx1 < width ? tx1 : width - 1;
+        if (ty >= 0 && ty < height && tx0 <= last) {
+            const uint64_t* row = &bits[static_cast<size_t>(ty) * words_per_row];
+            for (int w = tx0 >> 6; w <= (last >> 6); w++) {
+                uint64_t word = row[w] & span_mask(w, tx0, last);
+                if (word) return (w << 6) + tile_bit_low(word);
+            }
+        }
+        if (tx1 >= width) return tx0 > width ? tx0 : width;
+        return tx1 + 1;
+    }
+
+    // Highest solid column in [tx0, tx1] on row ty, or tx0 - 1 if the span is clear
+    int row_last(int ty, int tx0, int tx1) const {
+        if (tx0 > tx1) return tx0 - 1;
+        if (tx1 >= width) return tx1;
+        int first = tx0 > 0 ? tx0 : 0;
+        if (ty >= 0 && ty < height && first <= tx1) {
+            const uint64_t* row = &bits[static_cast<size_t>(ty) * words_per_row];
+            for (int w = tx1 >> 6; w >= (first >> 6); w--) {
+                uint64_t word = row[w] & span_mask(w, first, tx1);
+                if (word) return (w << 6) + tile_bit_high(word);
+            }
+        }
+        if (tx0 < 0) return tx1 < -1 ? tx1 : -1;
+        return tx0 - 1;
+    }
+
+    // True if any tile in [tx0, tx1] on row ty is solid
+    bool row_any(int ty, int tx0, int tx1) const {
+        return row_first(ty, tx0, tx1) <= tx1;
+    }
+
+private:
+    // Bits of word w that fall inside columns [tx0, tx1]
+    static uint64_t span_mask(int w, int tx0, int tx1) {
+        int lo = (w << 6) > tx0 ? 0 : tx0 & 63;
+        int hi = ((w << 6) + 63) < tx1 ? 63 : tx1 & 63;
+        uint64_t upper = hi == 63 ? ~0ull : ((1ull << (hi + 1)) - 1);
+        return upper & (~0ull << lo);
+    }
+};
+
+//--------------------------SWEPT AABB MOVEMENT----------------------------------------
+
+/**
+ * @struct TileBody
+ * @brief Axis aligned box moved against a TileGrid. Contact flags are refreshed by every sweep.
+ */
+struct TileBody {
+    float x, y;             // Top-left position in pixels
+    float w, h;             // Size in pixels
+    float vx, vy;           // Velocity in pixels per second
+    bool on_ground;         // Landed on a solid tile during the last sweep
+    bool on_ceiling;        // Bumped a solid tile above
+    bool on_wall_left;      // Blocked moving left
+    bool on_wall_right;     // Blocked moving right
+};
+
+// Tile index containing pixel coordinate v
+inline int tile_floor(float v, int tile_size) {
+    return static_cast<int>(std::floor(v / tile_size));
+}
+
+/**
+ * @brief Move a body by (dx, dy), x axis first, stopping flush against the first solid tile.
+ *
+ * Each axis only visits the rows (or columns) the leading edge crosses, and every check is
+ * a word wide scan of a row span, so the cost depends on distance moved, not level size.
+ */
+inline void sweep_body(const TileGrid& grid, TileBody& b, float dx, float dy) {
+    const int ts = grid.tile_size;
+    const float skin = 0.001f;   // Keeps flush edges from counting as overlap
+
+    b.on_ground = b.on_ceiling = b.on_wall_left = b.on_wall_right = false;
+
+    if (dx != 0.0f) {
+        int r0 = tile_floor(b.y, ts);
+        int r1 = tile_floor(b.y + b.h - skin, ts);
+        if (dx > 0.0f) {
+            int c0 = tile_floor(b.x + b.w - skin, ts);
+            int c1 = tile_floor(b.x + b.w + dx - skin, ts);
+            int hit = c1 + 1;
+            for (int r = r0; r <= r1 && c1 > c0; r++) {
+                int c = grid.row_first(r, c0 + 1, c1);
+                if (c < hit) hit = c;
+            }
+            if (hit <= c1) {
+                b.x = static_cast<float>(hit * ts) - b.w;
+                b.vx = 0.0f;
+                b.on_wall_right = true;
+            } else {
+                b.x += dx;
+            }
+        } else {
+            int c0 = tile_floor(b.x, ts);
+            int c1 = tile_floor(b.x + dx, ts);
+            int hit = c1 - 1;
+            for (int r = r0; r <= r1 && c1 < c0; r++) {
+                int c = grid.row_last(r, c1, c0 - 1);
+                if (c > hit) hit = c;
+            }
+            if (hit >= c1) {
+                b.x = static_cast<float>((hit + 1) * ts);
+                b.vx = 0.0f;
+                b.on_wall_left = true;
+            } else {
+                b.x += dx;
+            }
+        }
+    }
+
+    if (dy != 0.0f) {
+        int c0 = tile_floor(b.x, ts);
+        int c1 = tile_floor(b.x + b.w - skin, ts);
+        if (dy > 0.0f) {
+            int r0 = tile_floor(b.y + b.h - skin, ts);
+            int r1 = tile_floor(b.y + b.h + dy - skin, ts);
+            b.y += dy;
+            for (int r = r0 + 1; r <= r1; r++) {
+                if (grid.row_any(r, c0, c1)) {
+                    b.y = static_cast<float>(r * ts) - b.h;
+                    b.vy = 0.0f;
+                    b.on_ground = true;
+                    break;
+                }
+            }
+        } else {
+            int r0 = tile_floor(b.y, ts);
+            int r1 = tile_floor(b.y + dy, ts);
+            b.y += dy;
+            for (int r = r0 - 1; r >= r1; r--) {
+                if (grid.row_any(r, c0, c1)) {
+                    b.y = static_cast<float>((r + 1) * ts);
+                    b.vy = 0.0f;
+                    b.on_ceiling = true;
+                    break;
+                }
+            }
+        }
+    }
+}
+
+// Integrate velocity for one step and resolve it against the grid
+inline void update_body(const TileGrid& grid, TileBody& b, float delta_time) {
+    sweep_body(grid, b, b.vx * delta_time, b.vy * delta_time);
+}
+
+// True if the row directly under the body's feet is solid anywhere beneath it
+inline bool ground_below(const TileGrid& grid, const TileBody& b) {
+    const float skin = 0.001f;
+    int ts = grid.tile_size;
+    return grid.row_any(tile_floor(b.y + b.h, ts), tile_floor(b.x, ts), tile_floor(b.x + b.w - skin, ts));
+}
+
+// True if the column just past the body's left / right edge is solid along its height
+inline bool wall_beside(const TileGrid& grid, const TileBody& b, int direction) {
+    const float skin = 0.001f;
+    int ts = grid.tile_size;
+    int col = direction < 0 ? tile_floor(b.x - skin, ts) : tile_floor(b.x + b.w, ts);
+    int r0 = tile_floor(b.y, ts);
+    int r1 = tile_floor(b.y + b.h - skin, ts);
+    for (int r = r0; r <= r1; r++) {
+        if (grid.is_solid(col, r)) return true;
+    }
+    return false;
+}
+
+#endif // TILEMAP_HPP
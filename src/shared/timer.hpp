@@ -0,0 +1,359 @@
+#ifndef TIMER_HPP
+#define TIMER_HPP
+
+/**
+ * @file timer.hpp
+ * @brief Game timers on a hierarchical timing wheel: grenade fuses, respawns, invulnerability
+ *  windows, "call this in 0.3 s". Scheduling and cancelling are O(1), and advancing the clock
+ *  only touches the timers that are due (plus an occasional cascade of far-off timers toward
+ *  the front), so the cost of a frame doesn't grow with the number of timers waiting.
+ *
+ *  Time is counted in ticks (1 ms by default). Four wheels of 256 slots cover ticks, 256 ticks,
+ *  65536 ticks and 16M ticks ahead; a timer sits in the coarsest wheel that fits its delay and
+ *  drops to finer wheels as its time comes closer. Timers further out than the last wheel wait
+ *  there and are placed again each time round.
+ *
+ *  Callbacks are stored inside the timer itself (up to TIMER_CALLBACK_BYTES of captures), never
+ *  in a std::function, and timers come from chunks that are reused, so a steady game allocates
+ *  nothing. Not thread safe: schedule, cancel and advance from the game thread.
+ */
+#include <vector>
+#include <new>
+#include <cstdint>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+//--------------------------TIMER HANDLE-----------------------------------------------
+
+const size_t TIMER_CALLBACK_BYTES = 48;     // Room for captures, e.g. this plus a few values
+
+// Refers to one scheduled timer. Stays safe to use after the timer fired or was cancelled:
+// the generation no longer matches and cancel / pending simply say no.
+struct TimerHandle {
+    uint32_t index;
+    uint32_t generation;        // 0 for a handle that never referred to anything
+
+    bool valid() const { return generation != 0; }
+};
+
+//--------------------------CLASS TIMERWHEEL-------------------------------------------
+
+/**
+ * @class TimerWheel
+ * @brief Timers by handle, fired from advance() in the order they fall due.
+ *
+ *  TimerWheel timers;
+ *  TimerHandle fuse = timers.after(2.5f, [&] { explode(grenade); });
+ *  timers.every(0.1f, [&] { hero.update(0.1f); });
+ *  ...each frame:
+ *  timers.advance(delta_time);
+ *  ...if the grenade is picked up:
+ *  timers.cancel(fuse);
+ *
+ *  A callback may schedule and cancel timers, itself included. A repeating timer fired late
+ *  (a long frame) keeps its rhythm: it fires once per missed period, each in order.
+ */
+class TimerWheel {
+public:
+    explicit TimerWheel(float tick_seconds = 0.001f)
+        : tick(tick_seconds > 0.0f ? tick_seconds : 0.001f), current(0), carry(0.0), free_head(NIL), live_count(0) {
+        for (uint32_t& head : heads) head = NIL;
+    }
+
+    ~TimerWheel() {
+        for (Node* chunk : chunks) {
+            for (size_t i = 0; i < CHUNK; i++) {
+                if (chunk[i].state != STATE_FREE) chunk[i].destroy(chunk[i].storage);
+            }
+            delete[] chunk;
+        }
+    }
+
+    TimerWheel(const TimerWheel&) = delete;
+    TimerWheel& operator=(const TimerWheel&) = delete;
+
+    // Call fn once, seconds from now
+    template <class F>
+    TimerHandle after(float seconds, F&& fn) {
+        return schedule(to_ticks(seconds), 0, std::forward<F>(fn));
+    }
+
+    // Call fn every seconds, first time seconds from now, until cancelled
+    template <class F>
+    TimerHandle every(float seconds, F&& fn) {
+        uint64_t period = to_ticks(seconds);
+        return schedule(period, period, std::forward<F>(fn));
+    }
+
+    // Same as after / every with the delay in ticks
+    template <class F>
+    TimerHandle schedule(uint64_t delay_ticks, uint64_t period_ticks, F&& fn) {
+        typedef typename std::decay<F>::type Fn;
+        static_assert(sizeof(Fn) <= TIMER_CALLBACK_BYTES, "Timer callback captures too much, capture a pointer instead");
+        static_assert(alignof(Fn) <= alignof(std::max_align_t), "Timer callback is over-aligned");
+
+        uint32_t index = allocate();
+        Node& n = node(index);
+        new (n.storage) Fn(std::forward<F>(fn));
+        n.call = &call_fn<Fn>;
+        n.destroy = &destroy_fn<Fn>;
+        n.expires = current + (delay_ticks ? delay_ticks : 1);
+        n.period = period_ticks;
+        n.state = STATE_WAITING;
+        place(index);
+        live_count++;
+        return TimerHandle{index, n.generation};
+    }
+
+    // Stop a timer before it fires; false if it already fired, was cancelled or is not ours
+    bool cancel(TimerHandle handle) {
+        if (!owns(handle)) return false;
+        Node& n = node(handle.index);
+        if (n.state == STATE_FIRING && n.period != 0) {
+            n.state = STATE_CANCELLED;          // Freed once its callback returns
+            live_count--;
+            return true;
+        }
+        if (n.state != STATE_WAITING) return false;
+        unlink(handle.index);
+        release(handle.index);
+        live_count--;
+        return true;
+    }
+
+    // True while the timer is waiting to fire (a repeating timer until it is cancelled)
+    bool pending(TimerHandle handle) const {
+        if (!owns(handle)) return false;
+        const Node& n = node(handle.index);
+        return n.state == STATE_WAITING || (n.state == STATE_FIRING && n.period != 0);
+    }
+
+    // Seconds until the timer fires, 0 if it isn't pending
+    float remaining(TimerHandle handle) const {
+        if (!pending(handle)) return 0.0f;
+        const Node& n = node(handle.index);
+        uint64_t due = n.state == STATE_FIRING ? n.expires + n.period : n.expires;
+        return static_cast<float>((due - current) * static_cast<double>(tick));
+    }
+
+    // Move the clock forward, firing every timer that falls due on the way
+    void advance(float delta_time) {
+        if (delta_time <= 0.0f) return;
+        carry += delta_time / static_cast<double>(tick);
+        uint64_t ticks = static_cast<uint64_t>(carry);
+        carry -= static_cast<double>(ticks);
+        advance_ticks(ticks);
+    }
+
+    void advance_ticks(uint64_t ticks) {
+        uint64_t target = current + ticks;
+        while (current < target) {
+            if (live_count == 0) {
+                current = target;                   // Nothing to fire or cascade on the way
+                return;
+            }
+            current++;
+            // Entering a new round of a wheel: bring that round's timers down a level
+            for (int level = 1; level < LEVELS && (current & ((1ull << (level * BITS)) - 1)) == 0; level++) {
+                cascade(level);
+            }
+            fire(list_of(0, current));
+        }
+    }
+
+    size_t size() const { return live_count; }
+    uint64_t now_ticks() const { return current; }
+    float now() const { return static_cast<float>(current * static_cast<double>(tick)); }
+    float tick_seconds() const { return tick; }
+
+private:
+    static const int LEVELS = 4;
+    static const int BITS = 8;
+    static const uint32_t SLOTS = 1u << BITS;
+    static const uint32_t LISTS = LEVELS * SLOTS + 1;    // Plus the list being fired
+    static const uint32_t FIRING_LIST = LEVELS * SLOTS;
+    static const uint32_t NIL = 0xFFFFFFFFu;
+    static const size_t CHUNK = 256;                      // Timers per allocation
+
+    enum State : uint8_t { STATE_FREE, STATE_WAITING, STATE_FIRING, STATE_CANCELLED };
+
+    struct Node {
+        alignas(std::max_align_t) unsigned char storage[TIMER_CALLBACK_BYTES];
+        void (*call)(void* fn);
+        void (*destroy)(void* fn);
+        uint64_t expires;           // Tick it fires at
+        uint64_t period;            // Ticks between repeats, 0 for one-shot
+        uint32_t prev, next;        // Neighbours in its list (or next free node)
+        uint32_t list;              // Which list it is in
+        uint32_t generation;
+        State state;
+    };
+
+    float tick;                     // Seconds per tick
+    uint64_t current;               // Ticks since the wheel was made
+    double carry;                   // Fraction of a tick not counted yet
+    uint32_t heads[LISTS];          // First node of each slot
+    std::vector<Node*> chunks;      // Nodes never move, so callbacks can stay where they were built
+    uint32_t free_head;
+    size_t live_count;
+
+    template <class Fn>
+    static void call_fn(void* fn) { (*static_cast<Fn*>(fn))(); }
+
+    template <class Fn>
+    static void destroy_fn(void* fn) { static_cast<Fn*>(fn)->~Fn(); }
+
+    Node& node(uint32_t index) { return chunks[index / CHUNK][index % CHUNK]; }
+    const Node& node(uint32_t index) const { return chunks[index / CHUNK][index % CHUNK]; }
+
+    bool owns(TimerHandle handle) const {
+        return handle.generation != 0 && handle.index < chunks.size() * CHUNK &&
+               node(handle.index).generation == handle.generation && node(handle.index).state != STATE_FREE;
+    }
+
+    uint64_t to_ticks(float seconds) const {
+        if (seconds <= 0.0f) return 1;
+        double ticks = seconds / static_cast<double>(tick) + 0.5;
+        return ticks < 1.0 ? 1 : static_cast<uint64_t>(ticks);
+    }
+
+    static uint32_t list_of(int level, uint64_t expires) {
+        return static_cast<uint32_t>(level) * SLOTS + static_cast<uint32_t>((expires >> (level * BITS)) & (SLOTS - 1));
+    }
+
+    uint32_t allocate() {
+        if (free_head == NIL) {
+            // Old chunks stay where they are; new ones extend the index range
+            uint32_t base = static_cast<uint32_t>(chunks.size() * CHUNK);
+            Node* chunk = new Node[CHUNK];
+            for (size_t i = 0; i < CHUNK; i++) {
+                chunk[i].state = STATE_FREE;
+                chunk[i].generation = 0;
+                chunk[i].next = i + 1 < CHUNK ? base + static_cast<uint32_t>(i) + 1 : NIL;
+            }
+            chunks.push_back(chunk);
+            free_head = base;
+        }
+        uint32_t index = free_head;
+        Node& n = node(index);
+        free_head = n.next;
+        if (++n.generation == 0) n.generation = 1;      // 0 is the empty handle
+        return index;
+    }
+
+    void release(uint32_t index) {
+        Node& n = node(index);
+        n.destroy(n.storage);
+        n.state = STATE_FREE;
+        n.generation++;                                 // Old handles stop matching at once
+        n.next = free_head;
+        free_head = index;
+    }
+
+    void push(uint32_t list, uint32_t index) {
+        Node& n = node(index);
+        n.list = list;
+        n.prev = NIL;
+        n.next = heads[list];
+        if (n.next != NIL) node(n.next).prev = index;
+        heads[list] = index;
+    }
+
+    void unlink(uint32_t index) {
+        Node& n = node(index);
+        if (n.prev != NIL) node(n.prev).next = n.next;
+        else heads[n.list] = n.next;
+        if (n.next != NIL) node(n.next).prev = n.prev;
+    }
+
+    // Put a waiting timer in the coarsest wheel that still tells its slot apart
+    void place(uint32_t index) {
+        uint64_t delta = node(index).expires - current;
+        int level = 0;
+        while (level < LEVELS - 1 && delta >= (1ull << ((level + 1) * BITS))) level++;
+        uint64_t at = node(index).expires;
+        if (delta >= (1ull << (LEVELS * BITS))) {
+            at = current + (1ull << (LEVELS * BITS)) - 1;     // Too far: wait a full turn, then look again
+        }
+        push(list_of(level, at), index);
+    }
+
+    void cascade(int level) {
+        uint32_t list = list_of(level, current);
+        uint32_t index = heads[list];
+        heads[list] = NIL;
+        while (index != NIL) {
+            uint32_t next = node(index).next;
+            place(index);
+            index = next;
+        }
+    }
+
+    void fire(uint32_t list) {
+        if (heads[list] == NIL) return;
+        // Move the slot aside so callbacks can cancel any timer in it, and add new ones freely
+        heads[FIRING_LIST] = heads[list];
+        heads[list] = NIL;
+        for (uint32_t index = heads[FIRING_LIST]; index != NIL; index = node(index).next) node(index).list = FIRING_LIST;
+
+        while (heads[FIRING_LIST] != NIL) {
+            uint32_t index = heads[FIRING_LIST];
+            unlink(index);
+            Node& n = node(index);
+            n.state = STATE_FIRING;
+            n.call(n.storage);
+            Node& after = node(index);                  // Same node; chunks never move
+            if (after.state == STATE_CANCELLED) {
+                release(index);
+            } else if (after.period != 0) {
+                after.state = STATE_WAITING;
+                after.expires += after.period;
+                if (after.expires <= current) after.expires = current + 1;   // Catch up one period per tick
+                place(index);
+            } else {
+                release(index);
+                live_count--;
+            }
+        }
+    }
+};
+
+// Timers of the running game
+inline TimerWheel& game_timers() {
+    static TimerWheel timers;
+    return timers;
+}
+
+//--------------------------MAIN-----------------------------------------------------
+//
+// 50000 pending timers (fuses, respawns) on top of a blinking hero; the frame cost stays flat.
+//
+// int main() {
+//     init_window(800, 600, "Timers", 60);
+//     Obj_ss hero("img/Attack1.png", 100, 40, 2.0f, 126, 126, 7, 0.1f);
+//
+//     TimerWheel& timers = game_timers();
+//     int explosions = 0;
+//     for (int i = 0; i < 50000; i++) timers.after(1.0f + (i % 6000) * 0.01f, [&explosions] { explosions++; });
+//     bool visible = true;
+//     TimerHandle blink = timers.every(0.15f, [&visible] { visible = !visible; });    // Invulnerable
+//     timers.after(3.0f, [&timers, blink, &visible] {
+//         timers.cancel(blink);
+//         visible = true;
+//     });
+//
+//     while (!window_should_close()) {
+//         timers.advance(1.0f / 60.0f);
+//         start_drawing();
+//         clear_screen(COLOR_WHITE);
+//         if (visible) hero.render(1.0f / 60.0f);
+//         stop_drawing();
+//         printf("%zu pending, %d exploded, %.2f ms\r", timers.size(), explosions, last_frame_ms());
+//     }
+//
+//     quit_window();
+//     return 0;
+// }
+
+#endif // TIMER_HPP
@@ -0,0 +1,286 @@
+#ifndef UI_HPP
+#define UI_HPP
+
+/**
+ * @file ui.hpp
+ * @brief Retained HUD / menu layer. Buttons, labels and counters are kept as data, drawn once
+ *  into an offscreen layer, and the layer is copied to the screen every frame. The layer is only
+ *  drawn again when a widget changes (new text or value, hover, press, shown or hidden), so a
+ *  HUD that sits still costs one texture copy per frame and no text rendering.
+ *
+ *  Include it after core.hpp; the backend policy adds a layer target to what core.hpp asks for:
+ *
+ *      typedef ... Layer;                                      // SDL_Texture*, RenderTexture2D*, sf::RenderTexture*
+ *      static Layer create_layer(int width, int height);       // nullptr if it can't
+ *      static void destroy_layer(Layer layer);
+ *      static void begin_layer(Layer layer);                   // Later draws go to the layer, cleared to transparent
+ *      static void end_layer(Layer layer);
+ *      static void draw_layer(Layer layer, int x, int y);      // One blended copy to the screen
+ *
+ *  The layer holds premultiplied alpha (textures blended onto transparent pixels), so draw_layer
+ *  composites with ONE, ONE_MINUS_SRC_ALPHA rather than plain alpha blending.
+ */
+#include <string>
+#include <vector>
+#include <cstdint>
+#include "core.hpp"
+#include "idle.hpp"
+
+//--------------------------WIDGET----------------------------------------------------
+
+enum WidgetKind : uint8_t {
+    WIDGET_BUTTON,          // Image that can be clicked
+    WIDGET_LABEL,           // Fixed or occasionally changed text
+    WIDGET_COUNTER          // Text prefix followed by a number, e.g. "Score: 120"
+};
+
+struct Widget {
+    WidgetKind kind;
+    int x, y, w, h;         // Position in the layer; w, h is the hit box for buttons
+    float scale;
+    bool visible;
+    bool hovered;           // Mouse over the button at the last update
+    bool pressed;           // Mouse went down on the button and is still down
+    bool clicked;           // Released over the button at the last update
+    int image;              // Index into the layer's textures, -1 for text
+    std::string text;       // Label text or counter prefix
+    long long value;        // Counter value
+    Color color;            // Text color
+};
+
+//--------------------------CLASS UILAYER---------------------------------------------
+
+/**
+ * @class BasicUiLayer
+ * @brief Widgets of one screen (a HUD, a menu) and the cached layer they are drawn into.
+ *  Widgets are referred to by the id the add_ functions return.
+ *
+ *  update() does the hit testing and redraws the layer if anything changed; call it before
+ *  start_drawing, since the backends can't switch targets in the middle of a frame. draw()
+ *  goes between start_drawing and stop_drawing. Coordinates are the game's (logical when
+ *  set_logical_resolution is used, see mouse_position).
+ */
+template <class Backend>
+class BasicUiLayer {
+public:
+    typedef typename Backend::Texture Texture;
+    typedef typename Backend::Layer Layer;
+    typedef TextureHandle<Backend> Handle;
+
+    BasicUiLayer(int width, int height)
+        : w(width), h(height), layer(nullptr), dirty(true), mouse_was_down(false), redraw_count(0) {}
+
+    ~BasicUiLayer() {
+        if (layer) Backend::destroy_layer(layer);
+    }
+
+    BasicUiLayer(const BasicUiLayer&) = delete;
+    BasicUiLayer& operator=(const BasicUiLayer&) = delete;
+
+    // Image button, e.g. "img/start_btn.png"; the hit box is the image at the given scale
+    int add_button(const std::string& path, int x, int y, float scale = 1.0f) {
+        Texture texture = nullptr;
+        AlphaMap alpha;
+        if (!Backend::load_texture(path, texture, alpha)) {
+            throw std::runtime_error("Failed to load texture: " + path);
+        }
+        images.emplace_back(texture, std::move(alpha));
+        const Handle& image = images.back();
+
+        Widget widget = make(WIDGET_BUTTON, x, y, Color{255, 255, 255, 255});
+        widget.w = static_cast<int>(image.source_width() * scale);
+        widget.h = static_cast<int>(image.source_height() * scale);
+        widget.scale = scale;
+        widget.image = static_cast<int>(images.size()) - 1;
+        return add(widget);
+    }
+
+    int add_label(const std::string& text, int x, int y, Color color) {
+        Widget widget = make(WIDGET_LABEL, x, y, color);
+        widget.text = text;
+        return add(widget);
+    }
+
+    int add_counter(const std::string& prefix, long long value, int x, int y, Color color) {
+        Widget widget = make(WIDGET_COUNTER, x, y, color);
+        widget.text = prefix;
+        widget.value = value;
+        return add(widget);
+    }
+
+    // Setters only mark the layer dirty when something actually changes, so they can be called every frame
+    void set_text(int id, const std::string& text) {
+        if (widgets[id].text != text) {
+            widgets[id].text = text;
+            touch();
+        }
+    }
+
+    void set_value(int id, long long value) {
+        if (widgets[id].value != value) {
+            widgets[id].value = value;
+            touch();
+        }
+    }
+
+    void set_visible(int id, bool visible) {
+        if (widgets[id].visible != visible) {
+            widgets[id].visible = visible;
+            touch();
+        }
+    }
+
+    void move(int id, int x, int y) {
+        if (widgets[id].x != x || widgets[id].y != y) {
+            widgets[id].x = x;
+            widgets[id].y = y;
+            touch();
+        }
+    }
+
+    const Widget& widget(int id) const { return widgets[id]; }
+    bool clicked(int id) const { return widgets[id].clicked; }
+    bool hovered(int id) const { return widgets[id].hovered; }
+
+    /**
+     * @brief Hit-test the buttons against the mouse and redraw the layer if anything changed.
+     *  A click is a press and a release over the same button.
+     */
+    void update(int mouse_x, int mouse_y, bool mouse_down) {
+        bool went_down = mouse_down && !mouse_was_down;
+        bool went_up = !mouse_down && mouse_was_down;
+        mouse_was_down = mouse_down;
+
+        for (Widget& widget : widgets) {
+            widget.clicked = false;
+            if (widget.kind != WIDGET_BUTTON) continue;
+            bool over = widget.visible && mouse_x >= widget.x && mouse_y >= widget.y &&
+                        mouse_x < widget.x + widget.w && mouse_y < widget.y + widget.h;
+            bool pressed = widget.pressed;
+            if (went_down) pressed = over;
+            if (went_up) {
+                widget.clicked = pressed && over;
+                pressed = false;
+            }
+            if (over != widget.hovered || pressed != widget.pressed) {
+                widget.hovered = over;
+                widget.pressed = pressed;
+                touch();
+            }
+        }
+
+        if (dirty) render();
+    }
+
+    // Copy the cached layer to the screen
+    void draw(int x = 0, int y = 0) const {
+        if (layer) Backend::draw_layer(layer, x, y);
+    }
+
+    void invalidate() { touch(); }
+
+    // Times the layer has been drawn again, to check the HUD really is idle
+    size_t redraws() const { return redraw_count; }
+
+private:
+    int w, h;
+    Layer layer;
+    std::vector<Widget> widgets;
+    std::vector<Handle> images;     // Button textures, indexed by Widget::image
+    bool dirty;                     // Layer no longer matches the widgets
+    bool mouse_was_down;
+    size_t redraw_count;
+
+    Widget make(WidgetKind kind, int x, int y, Color color) const {
+        Widget widget;
+        widget.kind = kind;
+        widget.x = x;
+        widget.y = y;
+        widget.w = widget.h = 0;
+        widget.scale = 1.0f;
+        widget.visible = true;
+        widget.hovered = widget.pressed = widget.clicked = false;
+        widget.image = -1;
+        widget.value = 0;
+        widget.color = color;
+        return widget;
+    }
+
+    int add(const Widget& widget) {
+        widgets.push_back(widget);
+        touch();
+        return static_cast<int>(widgets.size()) - 1;
+    }
+
+    void touch() {
+        dirty = true;
+        mark_dirty();           // The screen changes with the layer (see idle.hpp)
+    }
+
+    void render() {
+        if (!layer) layer = Backend::create_layer(w, h);
+        if (!layer) return;
+
+        Backend::begin_layer(layer);
+        for (const Widget& widget : widgets) {
+            if (!widget.visible) continue;
+            if (widget.kind == WIDGET_BUTTON) {
+                const Handle& image = images[widget.image];
+                // Hovered buttons grow a little around their center, pressed ones sink by two pixels
+                float s = widget.scale * (widget.hovered && !widget.pressed ? 1.06f : 1.0f);
+                float x = widget.x + (widget.w - image.source_width() * s) / 2;
+                float y = widget.y + (widget.h - image.source_height() * s) / 2 + (widget.pressed ? 2.0f : 0.0f);
+                DrawRect dst = place_rect(x, y, s, image.offset_x(), image.offset_y(), image.width(), image.height(),
+                                          image.source_width(), image.source_height(), 0.0f, FLIP_NONE);
+                Backend::draw_texture(image.get(), nullptr, dst, image.opaque());
+            } else if (widget.kind == WIDGET_LABEL) {
+                draw_text(widget.text.c_str(), widget.x, widget.y, widget.color);
+            } else {
+                std::string text = widget.text + std::to_string(widget.value);
+                draw_text(text.c_str(), widget.x, widget.y, widget.color);
+            }
+        }
+        Backend::end_layer(layer);
+        dirty = false;
+        redraw_count++;
+    }
+};
+
+//--------------------------MAIN-----------------------------------------------------
+//
+// int main() {
+//     init_window(800, 600, "HUD", 60);
+//
+//     UiLayer menu(800, 600);
+//     int start = menu.add_button("img/start_btn.png", 300, 200);
+//     int restart = menu.add_button("img/restart_btn.png", 300, 320);
+//     int quit = menu.add_button("img/exit_btn.png", 300, 440);
+//     int score = menu.add_counter("Score: ", 0, 20, 20, COLOR_BLACK);
+//     menu.add_label("Heavy", 20, 560, COLOR_BLACK);
+//
+//     Obj_ss hero("img/Attack1.png", 100, 40, 2.0f, 126, 126, 7, 0.1f);
+//     long long points = 0;
+//     int frames = 0;
+//     while (!window_should_close()) {
+//         int mouse_x, mouse_y;
+//         mouse_position(mouse_x, mouse_y);
+//         menu.set_value(score, points / 60);             // Redraws the layer once a second
+//         menu.update(mouse_x, mouse_y, mouse_down());
+//         if (menu.clicked(quit)) break;
+//         if (menu.clicked(start) || menu.clicked(restart)) points = 0;
+//         points++;
+//
+//         start_drawing();
+//         clear_screen(COLOR_WHITE);
+//         hero.render(1.0f / 60.0f);
+//         menu.draw();                                     // One texture copy
+//         stop_drawing();
+//
+//         if (++frames % 300 == 0) printf("%zu layer redraws in %d frames\n", menu.redraws(), frames);
+//     }
+//
+//     quit_window();
+//     return 0;
+// }
+
+#endif // UI_HPP